@@ -639,14 +639,28 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
+    // converting string that we try to find to lower case
+    std::wstring wsearchedname;
+    if (!Utf8toWStr(searchedname, wsearchedname))
+        return;
+
+    wstrToLower(wsearchedname);
+
+    // Filter, only the matching auctions need to be sorted
     std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
+    if (isFull)
+    {
+        AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
+        auctions.reserve(aucs.size());
 
-    for (const auto& auc : aucs)
-        auctions.push_back(auc.second);
+        for (const auto& auc : aucs)
+            auctions.push_back(auc.second);
+    }
+    else
+        auctionHouse->FindAuctions(auctions, wsearchedname, GetSessionDbLocaleIndex(), levelmin, levelmax,
+                                   auctionSlotID, auctionMainCategory, auctionSubCategory, quality);
 
+    // Sort
     AuctionSorter sorter(Sort, GetPlayer());
     std::sort(auctions.begin(), auctions.end(), sorter);
 
@@ -658,15 +672,7 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     uint32 totalcount = 0;
     data << uint32(0);
 
-    // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(searchedname, wsearchedname))
-        return;
-
-    wstrToLower(wsearchedname);
-
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-                          auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull != 0);
+    BuildListAuctionItems(auctions, data, listfrom, usable, count, totalcount, isFull != 0);
 
     data.put<uint32>(0, count);
     data << uint32(totalcount);
@@ -476,6 +476,25 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
     return true;
 }
 
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemPrototype const* proto, int32 loc_idx)
+{
+    uint64 key = (uint64(loc_idx + 1) << 32) | proto->ItemId;
+    ItemSearchNameMap::const_iterator itr = mItemSearchNames.find(key);
+    if (itr != mItemSearchNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+
+    std::wstring& wname = mItemSearchNames[key];
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();                                      // never matches a search
+
+    return wname;
+}
+
 void AuctionHouseMgr::Update()
 {
     for (auto& mAuction : mAuctions)
@@ -574,6 +593,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
+                RemoveFromTemplateIndex(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
                 continue;
@@ -592,6 +612,7 @@ void AuctionHouseObject::Update()
                     sAuctionMgr.SendAuctionExpiredMail(itr->second);
 
                     itr->second->DeleteFromDB();
+                    RemoveFromTemplateIndex(itr->second);
                     delete itr->second;
                     AuctionsMap.erase(itr++);
                     continue;
@@ -603,6 +624,79 @@ void AuctionHouseObject::Update()
     }
 }
 
+void AuctionHouseObject::AddToTemplateIndex(AuctionEntry* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)                                             // can't be listed by browse filters anyway
+        return;
+
+    m_templateIndex[MakeTemplateIndexKey(proto->Class, proto->SubClass, proto->ItemId)].push_back(auction);
+}
+
+void AuctionHouseObject::RemoveFromTemplateIndex(AuctionEntry* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    AuctionTemplateIndex::iterator itr = m_templateIndex.find(MakeTemplateIndexKey(proto->Class, proto->SubClass, proto->ItemId));
+    if (itr == m_templateIndex.end())
+        return;
+
+    std::vector<AuctionEntry*>& auctions = itr->second;
+    std::vector<AuctionEntry*>::iterator aItr = std::find(auctions.begin(), auctions.end(), auction);
+    if (aItr != auctions.end())
+    {
+        *aItr = auctions.back();
+        auctions.pop_back();
+    }
+
+    if (auctions.empty())
+        m_templateIndex.erase(itr);
+}
+
+void AuctionHouseObject::FindAuctions(std::vector<AuctionEntry*>& auctions, std::wstring const& wsearchedname, int32 loc_idx, uint32 levelmin, uint32 levelmax,
+                                      uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality) const
+{
+    // restrict to the browsed category, class and subclass are the leading parts of the key
+    AuctionTemplateIndex::const_iterator first = m_templateIndex.begin();
+    AuctionTemplateIndex::const_iterator last = m_templateIndex.end();
+    if (itemClass != 0xffffffff)
+    {
+        if (itemSubClass != 0xffffffff)
+        {
+            first = m_templateIndex.lower_bound(MakeTemplateIndexKey(itemClass, itemSubClass, 0));
+            last = m_templateIndex.lower_bound(MakeTemplateIndexKey(itemClass, itemSubClass + 1, 0));
+        }
+        else
+        {
+            first = m_templateIndex.lower_bound(MakeTemplateIndexKey(itemClass, 0, 0));
+            last = m_templateIndex.lower_bound(MakeTemplateIndexKey(itemClass + 1, 0, 0));
+        }
+    }
+
+    for (AuctionTemplateIndex::const_iterator itr = first; itr != last; ++itr)
+    {
+        ItemPrototype const* proto = ObjectMgr::GetItemPrototype(uint32(itr->first));
+        if (!proto)
+            continue;
+
+        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+            continue;
+
+        if (quality != 0xffffffff && proto->Quality < quality)
+            continue;
+
+        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+            continue;
+
+        if (!wsearchedname.empty() && sAuctionMgr.GetItemSearchName(proto, loc_idx).find(wsearchedname) == std::wstring::npos)
+            continue;
+
+        auctions.insert(auctions.end(), itr->second.begin(), itr->second.end());
+    }
+}
+
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -795,11 +889,10 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-        uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const
+// auctions are already filtered by their item template in AuctionHouseObject::FindAuctions unless isFull
+void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, uint32 listfrom, uint32 usable,
+        uint32& count, uint32& totalcount, bool isFull) const
 {
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
-
     for (auto Aentry : auctions)
     {
         if (Aentry->moneyDeliveryTime)
@@ -817,21 +910,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
         {
             ItemPrototype const* proto = item->GetProto();
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
-
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
-
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-                continue;
-
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
-
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-                continue;
-
             if (usable != 0x00)
             {
                 if (_player->CanUseItem(item) != EQUIP_ERR_OK)
@@ -847,12 +925,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 }
             }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
-
             if (count < 50 && totalcount >= listfrom)
             {
                 ++count;
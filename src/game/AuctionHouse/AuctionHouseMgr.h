@@ -26,6 +26,7 @@ class Item;
 class Player;
 class Unit;
 class WorldPacket;
+struct ItemPrototype;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_SORT 12
@@ -98,6 +99,8 @@ class AuctionHouseObject
 
         typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
+        // auctions grouped by item class, subclass and template, see MakeTemplateIndexKey
+        typedef std::map<uint64, std::vector<AuctionEntry*>> AuctionTemplateIndex;
 
         uint32 GetCount() const { return AuctionsMap.size(); }
 
@@ -108,6 +111,7 @@ class AuctionHouseObject
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            AddToTemplateIndex(ah);
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -118,18 +122,37 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id)
         {
-            return AuctionsMap.erase(id) > 0;
+            AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+            if (itr == AuctionsMap.end())
+                return false;
+
+            RemoveFromTemplateIndex(itr->second);
+            AuctionsMap.erase(itr);
+            return true;
         }
 
         void Update();
 
+        // collects the auctions whose item template matches the browse filters, template checks are done once for all its auctions
+        void FindAuctions(std::vector<AuctionEntry*>& auctions, std::wstring const& wsearchedname, int32 loc_idx, uint32 levelmin, uint32 levelmax,
+                          uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality) const;
+
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
         void BuildListPendingSales(WorldPacket& data, Player* player, uint32& count);
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        static uint64 MakeTemplateIndexKey(uint32 itemClass, uint32 itemSubClass, uint32 itemTemplate)
+        {
+            return (uint64(itemClass) << 48) | (uint64(itemSubClass) << 32) | itemTemplate;
+        }
+
+        void AddToTemplateIndex(AuctionEntry* auction);
+        void RemoveFromTemplateIndex(AuctionEntry* auction);
+
         AuctionEntryMap AuctionsMap;
+        AuctionTemplateIndex m_templateIndex;
 };
 
 class AuctionSorter
@@ -191,12 +214,19 @@ class AuctionHouseMgr
         void AddAItem(Item* it);
         bool RemoveAItem(uint32 id);
 
+        // lower case item name in the locale for auction browse name matching
+        std::wstring const& GetItemSearchName(ItemPrototype const* proto, int32 loc_idx);
+        void ClearItemSearchNames() { mItemSearchNames.clear(); }
+
         void Update();
 
     private:
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        typedef std::unordered_map<uint64, std::wstring> ItemSearchNameMap;
+        ItemSearchNameMap   mItemSearchNames;               // (locale index + 1) << 32 | item id
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
@@ -273,8 +273,10 @@ ChatCommand* ChatHandler::getCommandTable()
     static ChatCommand debugPerformanceCommandTable[] =
     {
         { "maps",           SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugMaps,                       "", nullptr },
+        { "mapschedule",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMapSchedule,                "", nullptr },
         { "tempspawn",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleShowTemporarySpawnList,          "", nullptr },
         { "gridsloaded",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridsLoadedCount,                "", nullptr },
+        { "compression",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugCompression,                "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -286,8 +286,10 @@ class ChatHandler
         bool HandleDebugIsVisibleCommand(char* args);
 
         bool HandleDebugMaps(char* args);
+        bool HandleDebugMapSchedule(char* args);
         bool HandleShowTemporarySpawnList(char* args);
         bool HandleGridsLoadedCount(char* args);
+        bool HandleDebugCompression(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlayMovieCommand(char* args);
@@ -28,6 +28,7 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <fstream>
 #include "Maps/MapManager.h"
+#include "World/World.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
 #include "Spells/SpellMgr.h"
@@ -1247,6 +1248,18 @@ bool ChatHandler::HandleDebugMaps(char* /*args*/)
     PSendSysMessage("Map[530] >> Min: %ums, Max: %ums, Avg: %ums",
         sMapMgr.GetMapUpdateMinTime(530), sMapMgr.GetMapUpdateMaxTime(530), sMapMgr.GetMapUpdateAvgTime(530));
 
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_UPDATE_PARTITIONED))
+    {
+        PSendSysMessage("Partitioned update statistics:");
+        uint32 continents[] = { 0, 1, 530, 571 };
+        for (uint32 mapId : continents)
+        {
+            if (Map* map = sMapMgr.FindMap(mapId))
+                PSendSysMessage("Map[%u] >> Updates: %u, Partitions: %.1f, Speedup: %.2fx",
+                    mapId, map->GetPartitionedUpdateCount(), map->GetPartitionCountAvg(), map->GetPartitionSpeedup());
+        }
+    }
+
     if (m_session)
     {
         Player* player = m_session->GetPlayer();
@@ -1266,6 +1279,56 @@ bool ChatHandler::HandleDebugMaps(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleDebugMapSchedule(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 20))
+        return false;
+
+    std::vector<MapScheduleEntry> schedule = sMapMgr.GetLastUpdateSchedule();
+    if (schedule.empty())
+    {
+        SendSysMessage("Maps are not updated by map update threads.");
+        return true;
+    }
+
+    PSendSysMessage("Map update order of last tick (%u maps, most expensive first):", uint32(schedule.size()));
+    for (uint32 i = 0; i < schedule.size() && i < count; ++i)
+    {
+        MapScheduleEntry const& entry = schedule[i];
+        PSendSysMessage("%u. Map[%u] (Instance: %u) >> Cost: %.2fms, Players: %u",
+            i + 1, entry.mapId, entry.instanceId, entry.cost / 1000.0f, entry.players);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleDebugCompression(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        UpdateData::ResetCompressionStats();
+        SendSysMessage("Update packet compression statistics reset.");
+        return true;
+    }
+
+    UpdateCompressionStats stats = UpdateData::GetCompressionStats();
+    PSendSysMessage("Update packet compression (level %u, adaptive %s):", sWorld.getConfig(CONFIG_UINT32_COMPRESSION),
+        sWorld.getConfig(CONFIG_BOOL_COMPRESSION_ADAPTIVE) ? "on" : "off");
+    if (!stats.packets)
+    {
+        SendSysMessage("No update packets compressed yet.");
+        return true;
+    }
+
+    PSendSysMessage("Packets: " UI64FMTD " (fastest level: " UI64FMTD "), Avg size: " UI64FMTD " bytes",
+        stats.packets, stats.fastPackets, stats.rawBytes / stats.packets);
+    PSendSysMessage("Ratio: %.2f, Avg time: %.1fus, Throughput: %.1fMB/s",
+        double(stats.compressedBytes) / stats.rawBytes, double(stats.time) / stats.packets,
+        stats.time ? double(stats.rawBytes) / stats.time : 0.0);
+    return true;
+}
+
 bool ChatHandler::HandleShowTemporarySpawnList(char* /*args*/)
 {
     Player* pPlayer = m_session->GetPlayer();
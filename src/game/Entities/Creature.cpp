@@ -163,23 +163,14 @@ void Creature::AddToWorld()
 {
     ///- Register the creature for guid lookup
     if (!IsInWorld() && GetObjectGuid().IsCreatureOrVehicle())
-        GetMap()->GetObjectsStore().insert<Creature>(GetObjectGuid(), (Creature*)this);
+        GetMap()->InsertObject<Creature>(GetObjectGuid(), (Creature*)this);
 
     switch (GetSubtype())
     {
         case CREATURE_SUBTYPE_PET:
         case CREATURE_SUBTYPE_TEMPORARY_SUMMON:
-        {
-            std::map<uint32, uint32>& targetArray = GetMap()->GetTempCreatures();
-            if (GetSubtype() == CREATURE_SUBTYPE_PET)
-                targetArray = GetMap()->GetTempPets();
-            // If creature exists, add count
-            if (targetArray.find(this->GetEntry()) != targetArray.end())
-                ++targetArray[this->GetEntry()];
-            else
-                targetArray.insert(std::pair<uint32, uint32>(this->GetEntry(), 1));
+            GetMap()->AddTempCreature(GetEntry(), GetSubtype() == CREATURE_SUBTYPE_PET);
             break;
-        }
         default: break;
     }
 
@@ -203,25 +194,14 @@ void Creature::RemoveFromWorld()
     if (IsInWorld())
     {
         if (GetObjectGuid().IsCreatureOrVehicle())
-            GetMap()->GetObjectsStore().erase<Creature>(GetObjectGuid(), (Creature*)nullptr);
+            GetMap()->EraseObject<Creature>(GetObjectGuid());
 
         switch (GetSubtype())
         {
             case CREATURE_SUBTYPE_PET:
             case CREATURE_SUBTYPE_TEMPORARY_SUMMON:
-            {
-                std::map<uint32, uint32>& targetArray = GetMap()->GetTempCreatures();
-                if (GetSubtype() == CREATURE_SUBTYPE_PET)
-                    targetArray = GetMap()->GetTempPets();
-                if (targetArray.find(this->GetEntry()) != targetArray.end())
-                {
-                    --targetArray[this->GetEntry()];
-
-                    if (targetArray[this->GetEntry()] <= 0)
-                        targetArray.erase(this->GetEntry());
-                }
+                GetMap()->RemoveTempCreature(GetEntry(), GetSubtype() == CREATURE_SUBTYPE_PET);
                 break;
-            }
             default: break;
         }
 
@@ -39,7 +39,7 @@ void DynamicObject::AddToWorld()
 {
     ///- Register the dynamicObject for guid lookup
     if (!IsInWorld())
-        GetMap()->GetObjectsStore().insert<DynamicObject>(GetObjectGuid(), (DynamicObject*)this);
+        GetMap()->InsertObject<DynamicObject>(GetObjectGuid(), (DynamicObject*)this);
 
     WorldObject::AddToWorld();
 }
@@ -49,7 +49,7 @@ void DynamicObject::RemoveFromWorld()
     ///- Remove the dynamicObject from the accessor
     if (IsInWorld())
     {
-        GetMap()->GetObjectsStore().erase<DynamicObject>(GetObjectGuid(), (DynamicObject*)nullptr);
+        GetMap()->EraseObject<DynamicObject>(GetObjectGuid());
         GetViewPoint().Event_RemovedFromWorld();
     }
 
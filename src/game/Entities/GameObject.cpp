@@ -112,7 +112,7 @@ void GameObject::AddToWorld()
 {
     ///- Register the gameobject for guid lookup
     if (!IsInWorld())
-        GetMap()->GetObjectsStore().insert<GameObject>(GetObjectGuid(), (GameObject*)this);
+        GetMap()->InsertObject<GameObject>(GetObjectGuid(), (GameObject*)this);
 
     if (m_model)
         GetMap()->InsertGameObjectModel(*m_model);
@@ -156,7 +156,7 @@ void GameObject::RemoveFromWorld()
         if (m_model && GetMap()->ContainsGameObjectModel(*m_model))
             GetMap()->RemoveGameObjectModel(*m_model);
 
-        GetMap()->GetObjectsStore().erase<GameObject>(GetObjectGuid(), (GameObject*)nullptr);
+        GetMap()->EraseObject<GameObject>(GetObjectGuid());
     }
 
     Object::RemoveFromWorld();
@@ -52,6 +52,7 @@ Object::Object(): m_updateFlag(0), m_itsNewObject(false)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateIndex = 0;
     m_loot              = nullptr;
 }
 
@@ -198,7 +199,13 @@ void Object::SendCreateUpdateToPlayer(Player* player) const
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
 {
     ByteBuffer buf(500);
+    BuildValuesUpdateBlockForPlayer(buf, target);
+    data->AddUpdateBlock(buf);
+}
 
+// returns false if the block contains fields built for this target only
+bool Object::BuildValuesUpdateBlockForPlayer(ByteBuffer& buf, Player* target) const
+{
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
@@ -208,7 +215,52 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     _SetUpdateBits(&updateMask, target);
     BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
 
-    data->AddUpdateBlock(buf);
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (updateMask.GetBit(index) && IsViewerDependentUpdateField(index))
+            return false;
+
+    return true;
+}
+
+uint32 Object::GetUpdateViewerClass(Player* target) const
+{
+    if (target->isGameMaster())
+        return 0;
+
+    if (!isType(TYPEMASK_UNIT))
+        return 1;
+
+    Unit const* unit = static_cast<Unit const*>(this);
+    return 1 + (unit->IsFogOfWarVisibleHealth(target) ? 1 : 0) + (unit->IsFogOfWarVisibleStats(target) ? 2 : 0);
+}
+
+// fields that BuildValuesUpdate alters for each target beyond its viewer class
+bool Object::IsViewerDependentUpdateField(uint16 index) const
+{
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+            switch (index)
+            {
+                case UNIT_NPC_FLAGS:
+                    return GetTypeId() == TYPEID_UNIT;
+                case UNIT_FIELD_AURASTATE:
+                    return static_cast<Unit const*>(this)->HasAuraState(AURA_STATE_CONFLAGRATE);
+                case UNIT_DYNAMIC_FLAGS:
+                    return true;
+                case UNIT_FIELD_FACTIONTEMPLATE:
+                    return GetTypeId() == TYPEID_PLAYER && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP);
+                default:
+                    return false;
+            }
+        case TYPEID_GAMEOBJECT:
+            return index == GAMEOBJECT_DYNAMIC;
+        case TYPEID_CORPSE:
+            return index == CORPSE_FIELD_BYTES_1 && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP);
+        default:
+            return false;
+    }
 }
 
 void Object::BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
@@ -1091,7 +1143,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1102,7 +1154,37 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    // own fields are always built for the player only
+    if (!cache || pl == this)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    uint32 viewerClass = GetUpdateViewerClass(pl);
+    ByteBuffer& block = cache->blocks[viewerClass];
+    switch (cache->state[viewerClass])
+    {
+        case UpdateBlockCache::NOT_BUILT:
+            block.reserve(500);
+            if (BuildValuesUpdateBlockForPlayer(block, pl))
+                cache->state[viewerClass] = UpdateBlockCache::SHARED;
+            else
+            {
+                // the block was built for this viewer only, hand it over and build the others of the class separately
+                cache->state[viewerClass] = UpdateBlockCache::VIEWER_DEPENDENT;
+                iter->second.AddUpdateBlock(block);
+                block.clear();
+                return;
+            }
+            // no break
+        case UpdateBlockCache::SHARED:
+            iter->second.AddUpdateBlock(block);
+            break;
+        case UpdateBlockCache::VIEWER_DEPENDENT:
+            BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+            break;
+    }
 }
 
 void Object::AddToClientUpdateList()
@@ -2218,6 +2300,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    UpdateBlockCache i_blockCache;                          // all viewers see the object in the same state
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2232,7 +2315,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter.getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_blockCache);
         }
     }
 
@@ -143,6 +143,26 @@ class Spell;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// Viewers of an object that get the same values update block from it
+// gamemaster, or fog of war visibility of health and stats for other players
+#define MAX_UPDATE_VIEWER_CLASS 5
+
+// values update blocks of one object shared by all viewers of a class, valid while its changed values are not cleared
+struct UpdateBlockCache
+{
+    enum State
+    {
+        NOT_BUILT,
+        SHARED,
+        VIEWER_DEPENDENT                                    // contains fields built for each viewer
+    };
+
+    UpdateBlockCache() { std::fill(std::begin(state), std::end(state), NOT_BUILT); }
+
+    State state[MAX_UPDATE_VIEWER_CLASS];
+    ByteBuffer blocks[MAX_UPDATE_VIEWER_CLASS];
+};
+
 class CooldownData
 {
         friend class CooldownContainer;
@@ -399,6 +419,9 @@ class Object
         // must be overwrite in appropriate subclasses (WorldObject, Item currently), or will crash
         virtual void AddToClientUpdateList();
         virtual void RemoveFromClientUpdateList();
+        // position in the client update list of the map, checked by the map before it is used
+        void SetClientUpdateIndex(size_t index) { m_clientUpdateIndex = index; }
+        size_t GetClientUpdateIndex() const { return m_clientUpdateIndex; }
         virtual void BuildUpdateData(UpdateDataMapType& update_players);
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
@@ -614,7 +637,10 @@ class Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache = nullptr) const;
+        bool BuildValuesUpdateBlockForPlayer(ByteBuffer& buf, Player* target) const;
+        uint32 GetUpdateViewerClass(Player* target) const;
+        bool IsViewerDependentUpdateField(uint16 index) const;
 
         uint16 m_objectType;
 
@@ -633,6 +659,7 @@ class Object
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        size_t m_clientUpdateIndex;
 
     private:
         bool m_inWorld;
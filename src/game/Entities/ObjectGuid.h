@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "ByteBuffer.h"
 
+#include <atomic>
+
 enum TypeID
 {
     TYPEID_OBJECT        = 0,
@@ -246,7 +248,7 @@ class ObjectGuidGenerator
         uint32 GetNextAfterMaxUsed() const { return m_nextGuid; }
 
     private:                                                // fields
-        uint32 m_nextGuid;
+        std::atomic<uint32> m_nextGuid;
 };
 
 ByteBuffer& operator<< (ByteBuffer& buf, ObjectGuid const& guid);
@@ -26,6 +26,10 @@
 #include "Server/Opcodes.h"
 #include "World/World.h"
 #include "Entities/ObjectGuid.h"
+#include "TSS.h"
+
+#include <atomic>
+#include <chrono>
 
 
 UpdateData::UpdateData() : m_blockCount(0)
@@ -48,43 +52,132 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     ++m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+void UpdateData::Append(const UpdateData& data)
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    m_data.append(data.m_data);
+    m_blockCount += data.m_blockCount;
+    m_outOfRangeGUIDs.insert(data.m_outOfRangeGUIDs.begin(), data.m_outOfRangeGUIDs.end());
+}
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+namespace
+{
+    // deflate state is about 256KB, keep one per thread instead of initializing it for every packet
+    struct UpdateCompressor
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        UpdateCompressor() : initialized(false), level(0)
+        {
+            stream.zalloc = (alloc_func)nullptr;
+            stream.zfree = (free_func)nullptr;
+            stream.opaque = (voidpf)nullptr;
+        }
+
+        ~UpdateCompressor()
+        {
+            if (initialized)
+                deflateEnd(&stream);
+        }
+
+        z_stream stream;
+        bool initialized;
+        int level;
+        ByteBuffer buffer;                                  // uncompressed packet content, keeps its storage between packets
+    };
+
+    MaNGOS::thread_local_ptr<UpdateCompressor> s_compressor;
+
+    std::atomic<uint64> s_statPackets(0);
+    std::atomic<uint64> s_statFastPackets(0);
+    std::atomic<uint64> s_statRawBytes(0);
+    std::atomic<uint64> s_statCompressedBytes(0);
+    std::atomic<uint64> s_statTime(0);
+}
 
+UpdateCompressionStats UpdateData::GetCompressionStats()
+{
+    UpdateCompressionStats stats;
+    stats.packets = s_statPackets;
+    stats.fastPackets = s_statFastPackets;
+    stats.rawBytes = s_statRawBytes;
+    stats.compressedBytes = s_statCompressedBytes;
+    stats.time = s_statTime;
+    return stats;
+}
+
+void UpdateData::ResetCompressionStats()
+{
+    s_statPackets = 0;
+    s_statFastPackets = 0;
+    s_statRawBytes = 0;
+    s_statCompressedBytes = 0;
+    s_statTime = 0;
+}
+
+int UpdateData::GetCompressionLevel(size_t size)
+{
+    int level = sWorld.getConfig(CONFIG_UINT32_COMPRESSION);
+    if (level == Z_BEST_SPEED || !sWorld.getConfig(CONFIG_BOOL_COMPRESSION_ADAPTIVE))
+        return level;
+
+    // compression time grows with the level much faster than the ratio, so spend it only on small packets
+    // and only while the world keeps up with its update interval
+    if (size > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_ADAPTIVE_SIZE) || World::GetCurrentDiff() > sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))
+        return Z_BEST_SPEED;
+
+    return level;
+}
+
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    UpdateCompressor* compressor = s_compressor.get();
+    z_stream& c_stream = compressor->stream;
+
+    int level = GetCompressionLevel(src_size);
+    int z_res;
+
+    // deflateParams may already write the stream header, so the output has to be the one of this packet
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream.next_in = nullptr;
+    c_stream.avail_in = 0;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
+    if (!compressor->initialized)
     {
-        sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        // default Z_BEST_SPEED (1)
+        z_res = deflateInit(&c_stream, level);
+        if (z_res != Z_OK)
+        {
+            sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+            *dst_size = 0;
+            return;
+        }
+        compressor->initialized = true;
+        compressor->level = level;
     }
-
-    if (c_stream.avail_in != 0)
+    else
     {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
+        z_res = deflateReset(&c_stream);
+        if (z_res == Z_OK && compressor->level != level)
+        {
+            // no input is given yet, at most the stream header is flushed into dst
+            z_res = deflateParams(&c_stream, level, Z_DEFAULT_STRATEGY);
+            compressor->level = level;
+        }
+
+        if (z_res != Z_OK)
+        {
+            sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+            deflateEnd(&c_stream);
+            compressor->initialized = false;
+            *dst_size = 0;
+            return;
+        }
     }
 
+    auto start = std::chrono::steady_clock::now();
+
+    c_stream.next_in = (Bytef*)src;
+    c_stream.avail_in = (uInt)src_size;
+
     z_res = deflate(&c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
@@ -93,22 +186,23 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
+
+    ++s_statPackets;
+    if (level != int(sWorld.getConfig(CONFIG_UINT32_COMPRESSION)))
+        ++s_statFastPackets;
+    s_statRawBytes += src_size;
+    s_statCompressedBytes += c_stream.total_out;
+    s_statTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
 }
 
 bool UpdateData::BuildPacket(WorldPacket& packet)
 {
     MANGOS_ASSERT(packet.empty());                         // shouldn't happen
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    ByteBuffer& buf = s_compressor->buffer;
+    buf.clear();
+    buf.reserve(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
 
     buf << (uint32)(!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 
@@ -49,6 +49,15 @@ enum ObjectUpdateFlags
     UPDATEFLAG_ROTATION             = 0x0200
 };
 
+struct UpdateCompressionStats
+{
+    uint64 packets;                                         // compressed update packets
+    uint64 fastPackets;                                     // packets lowered to the fastest level by Compression.Adaptive
+    uint64 rawBytes;
+    uint64 compressedBytes;
+    uint64 time;                                            // in microseconds
+};
+
 class UpdateData
 {
     public:
@@ -57,17 +66,23 @@ class UpdateData
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
+        // add the blocks and out of range guids of data behind the own ones
+        void Append(const UpdateData& data);
         bool BuildPacket(WorldPacket& packet);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        static UpdateCompressionStats GetCompressionStats();
+        static void ResetCompressionStats();
+
     protected:
         uint32 m_blockCount;
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
+        static int GetCompressionLevel(size_t size);
         static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
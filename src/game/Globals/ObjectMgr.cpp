@@ -1373,8 +1373,9 @@ void ObjectMgr::LoadCreatureSpawnEntry()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    QueryResult* result = WorldDatabase.QuerySnapshot("creature", "creature, game_event_creature, pool_creature, pool_creature_template",
+                          //      0               1            2    3
+                          "SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7           8            9             10                   11           12
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist, currentwaypoint,"
                           //   13         14       15          16            17         18         19
@@ -1634,8 +1635,9 @@ void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                0                           1   2    3           4           5           6
-    QueryResult* result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    QueryResult* result = WorldDatabase.QuerySnapshot("gameobject", "gameobject, game_event_gameobject, pool_gameobject, pool_gameobject_template",
+                          //      0                1              2    3           4           5           6
+                          "SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           //   7          8          9          10         11                 12               13         14       15         16      17
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecsmin, spawntimesecsmax, animprogress, state, spawnMask, phaseMask, event,"
                           //   18                          19
@@ -54,10 +54,43 @@ namespace MaNGOS
         void Visit(CameraMapType&);
     };
 
+    // Broadcast message, small messages and the first receivers get plain copies, once enough receivers
+    // showed up the message is copied a last time and all further receivers share its content
+    class BroadcastPacket
+    {
+        public:
+            explicit BroadcastPacket(WorldPacket const& msg) : m_message(msg), m_copies(0) {}
+
+            void SendTo(WorldSession* session)
+            {
+                if (!m_shared)
+                {
+                    if (m_message.size() <= SharedMinSize || m_copies < SharedMinReceivers - 1)
+                    {
+                        ++m_copies;
+                        session->SendPacket(m_message);
+                        return;
+                    }
+
+                    m_shared = std::make_shared<const WorldPacket>(m_message);
+                }
+
+                session->SendPacket(m_shared);
+            }
+
+        private:
+            static const size_t SharedMinSize = 256;        // smaller content is copied by the socket anyway
+            static const uint32 SharedMinReceivers = 3;
+
+            WorldPacket const& m_message;
+            std::shared_ptr<const WorldPacket> m_shared;
+            uint32 m_copies;
+    };
+
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        BroadcastPacket i_message;
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket const& msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
@@ -67,7 +100,7 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket const& i_message;
+        BroadcastPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket const& msg, Player const* skipped)
@@ -80,7 +113,7 @@ namespace MaNGOS
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket const& i_message;
+        BroadcastPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket const& msg)
             : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
         void Visit(CameraMapType& m);
@@ -90,7 +123,7 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        BroadcastPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -104,7 +137,7 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket const& i_message;
+        BroadcastPacket i_message;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket const& msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
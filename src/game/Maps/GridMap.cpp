@@ -76,113 +76,189 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char const* filename)
+bool GridMap::loadData(char const* filename, bool mapped /*= false*/)
 {
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    // the file is parsed from memory, either mapped or read at once
+    std::vector<uint8> buffer;
+    uint8 const* data = nullptr;
+    uint32 dataSize = 0;
+
+    if (mapped)
     {
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
-        // its a valid error only in case of no vmap files are available too
-        return true;
+        m_file.reset(new MappedFile());
+        if (m_file->Open(filename))
+        {
+            data = m_file->GetData();
+            dataSize = uint32(m_file->GetSize());
+        }
+        else
+            m_file.reset();
     }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!data)
     {
-        sLog.outError("Error loading GridMapFileHeader\n");
+        // Not return error if file not found
+        FILE* in = fopen(filename, "rb");
+        if (!in)
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
+            // its a valid error only in case of no vmap files are available too
+            return true;
+        }
+
+        fseek(in, 0, SEEK_END);
+        long fileSize = ftell(in);
+        fseek(in, 0, SEEK_SET);
+
+        buffer.resize(fileSize > 0 ? size_t(fileSize) : 0);
+        if (buffer.empty() || fread(&buffer[0], buffer.size(), 1, in) != 1)
+        {
+            sLog.outError("Error loading GridMapFileHeader\n");
+            fclose(in);
+            return false;
+        }
+
         fclose(in);
+        data = &buffer[0];
+        dataSize = uint32(buffer.size());
+    }
+
+    GridMapFileHeader header;
+    if (dataSize < sizeof(header))
+    {
+        sLog.outError("Error loading GridMapFileHeader\n");
+        unloadData();
         return false;
     }
 
+    memcpy(&header, data, sizeof(header));
+
     if (header.mapMagic == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) &&
             IsAcceptableClientBuild(header.buildMagic))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(data, dataSize, header.areaMapOffset))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(data, dataSize, header.heightMapOffset))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(data, dataSize, header.liquidMapOffset))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data (if any. check header.holesOffset)
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesOffset && !loadHolesData(data, dataSize, header.holesOffset))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
+template<typename T>
+void GridMap::freeArray(T*& array)
+{
+    if (!array)
+        return;
+
+    uint8 const* address = reinterpret_cast<uint8 const*>(array);
+    if (!m_file || address < m_file->GetData() || address >= m_file->GetData() + m_file->GetSize())
+        delete[] array;
+
+    array = nullptr;
+}
+
 void GridMap::unloadData()
 {
-    if (m_area_map)    { delete[] m_area_map;    m_area_map = nullptr; }
-    if (m_V9)          { delete[] m_V9;          m_V9 = nullptr; }
-    if (m_V8)          { delete[] m_V8;          m_V8 = nullptr; }
-    if (m_liquidEntry) { delete[] m_liquidEntry; m_liquidEntry = nullptr; }
-    if (m_liquidFlags) { delete[] m_liquidFlags; m_liquidFlags = nullptr; }
-    if (m_liquid_map)  { delete[] m_liquid_map;  m_liquid_map = nullptr; }
-    if (m_holes)       { delete[] m_holes;       m_holes = nullptr; }
+    freeArray(m_area_map);
+    freeArray(m_V9);
+    freeArray(m_V8);
+    freeArray(m_liquidEntry);
+    freeArray(m_liquidFlags);
+    freeArray(m_liquid_map);
+    freeArray(m_holes);
+
+    m_file.reset();
 
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<typename T>
+bool GridMap::loadArray(T*& array, uint32 count, uint8 const* data, uint32 dataSize, uint32& offset)
 {
-    GridMapAreaHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    uint32 size = count * sizeof(T);
+    if (offset > dataSize || size > dataSize - offset)
+        return false;
+
+    // the .map format does not align its arrays, only aligned ones are used from the mapping in place
+    uint8 const* source = data + offset;
+    if (m_file && reinterpret_cast<uintptr_t>(source) % alignof(T) == 0)
+        array = reinterpret_cast<T*>(const_cast<uint8*>(source));
+    else
+    {
+        array = new T[count];
+        memcpy(array, source, size);
+    }
+
+    offset += size;
+    return true;
+}
+
+template<typename T>
+static bool readGridMapHeader(T& header, uint8 const* data, uint32 dataSize, uint32& offset)
+{
+    if (offset > dataSize || sizeof(T) > dataSize - offset)
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+
+    memcpy(&header, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+bool GridMap::loadAreaData(uint8 const* data, uint32 dataSize, uint32 offset)
+{
+    GridMapAreaHeader header;
+    if (!readGridMapHeader(header, data, dataSize, offset))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
-    {
-        m_area_map = new uint16 [16 * 16];
-        if (fread(m_area_map, sizeof(uint16), 16 * 16, in) != 16 * 16)
-            return false;
-    }
+        return loadArray(m_area_map, 16 * 16, data, dataSize, offset);
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint8 const* data, uint32 dataSize, uint32 offset)
 {
     GridMapHeightHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!readGridMapHeader(header, data, dataSize, offset))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
@@ -192,30 +268,24 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16[129 * 129];
-            m_uint16_V8 = new uint16[128 * 128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
+            if (!loadArray(m_uint16_V9, 129 * 129, data, dataSize, offset) ||
+                    !loadArray(m_uint16_V8, 128 * 128, data, dataSize, offset))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8[129 * 129];
-            m_uint8_V8 = new uint8[128 * 128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
+            if (!loadArray(m_uint8_V9, 129 * 129, data, dataSize, offset) ||
+                    !loadArray(m_uint8_V8, 128 * 128, data, dataSize, offset))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float[129 * 129];
-            m_V8 = new float[128 * 128];
-            if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
-                    fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
+            if (!loadArray(m_V9, 129 * 129, data, dataSize, offset) ||
+                    !loadArray(m_V8, 128 * 128, data, dataSize, offset))
                 return false;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -226,20 +296,15 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint8 const* data, uint32 dataSize, uint32 offset)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-    m_holes = new uint16[16 * 16];
-    return fread(m_holes, sizeof(uint16), 16 * 16, in) == 16 * 16;
+    return loadArray(m_holes, 16 * 16, data, dataSize, offset);
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint8 const* data, uint32 dataSize, uint32 offset)
 {
     GridMapLiquidHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!readGridMapHeader(header, data, dataSize, offset))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
@@ -254,19 +319,16 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        if (fread(m_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!loadArray(m_liquidEntry, 16 * 16, data, dataSize, offset))
             return false;
 
-        m_liquidFlags = new uint8[16 * 16];
-        if (fread(m_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
+        if (!loadArray(m_liquidFlags, 16 * 16, data, dataSize, offset))
             return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float[m_liquid_width * m_liquid_height];
-        if (fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in) != size_t(m_liquid_width * m_liquid_height))
+        if (!loadArray(m_liquid_map, m_liquid_width * m_liquid_height, data, dataSize, offset))
             return false;
     }
 
@@ -526,6 +588,28 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c) * m_gridIntHeightMultiplier + m_gridHeight;
 }
 
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    // the loops call the height functions directly, so they are inlined instead of called through m_gridGetHeight per point
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromFloat(x[i], y[i]);
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint16)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromUint16(x[i], y[i]);
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint8)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromUint8(x[i], y[i]);
+    }
+    else
+        std::fill(heights, heights + count, m_gridHeight);
+}
+
 float GridMap::getLiquidLevel(float x, float y) const
 {
     if (!m_liquid_map)
@@ -715,7 +799,7 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
     {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
-            m_GridMaps[i][k] = nullptr;
+            m_GridMaps[i][k].store(nullptr, std::memory_order_relaxed);
             m_GridRef[i][k] = 0;
         }
     }
@@ -733,7 +817,7 @@ TerrainInfo::~TerrainInfo()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
         for (auto& m_GridMap : m_GridMaps)
-            delete m_GridMap[k];
+            delete m_GridMap[k].load(std::memory_order_relaxed);
 
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
@@ -747,9 +831,9 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, bool mapOnly /*= fals
     // reference grid as a first step
     RefGrid(x, y);
 
-    // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[x][y];
-    if (!pMap)
+    // quick check if GridMap already loaded, a preloaded one still needs its vmap and navmesh
+    GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
+    if (!pMap || (!pMap->IsFullyLoaded() && !mapOnly))
         pMap = LoadMapAndVMap(x, y, mapOnly);
 
     return pMap;
@@ -761,7 +845,7 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    if (m_GridMaps[x][y])
+    if (m_GridMaps[x][y].load(std::memory_order_acquire))
     {
         // decrease grid reference count...
         if (UnrefGrid(x, y) == 0)
@@ -778,17 +862,20 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    // the grid preloader adds grids from its own thread
+    LOCK_GUARD lock(m_mutex);
+
     for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         {
             const int16& iRef = m_GridRef[x][y];
-            GridMap* pMap = m_GridMaps[x][y];
+            GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_relaxed);
 
             // delete those GridMap objects which have refcount = 0
             if (pMap && iRef == 0)
             {
-                m_GridMaps[x][y] = nullptr;
+                m_GridMaps[x][y].store(nullptr, std::memory_order_release);
                 // delete grid data if reference count == 0
                 pMap->unloadData();
                 delete pMap;
@@ -831,12 +918,42 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
         mapHeight = gmap->getHeight(x, y);
 
+    return SelectStaticHeight(x, y, z, mapHeight, useVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeightStatic(float const* x, float const* y, float* z, uint32 count, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    std::vector<float> mapHeights(count, VMAP_INVALID_HEIGHT_VALUE);
+
+    // sample the .map surface for each run of points in the same grid at once
+    for (uint32 start = 0; start < count;)
+    {
+        int gx = (int)(32 - x[start] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[start] / SIZE_OF_GRIDS);
+
+        uint32 end = start + 1;
+        while (end < count && (int)(32 - x[end] / SIZE_OF_GRIDS) == gx && (int)(32 - y[end] / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x[start], y[start]))
+            gmap->getHeights(x + start, y + start, &mapHeights[start], end - start);
+
+        start = end;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        z[i] = SelectStaticHeight(x[i], y[i], z[i], mapHeights[i], useVmaps, maxSearchDist);
+}
+
+float TerrainInfo::SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
     if (useVmaps)
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
@@ -1208,49 +1325,97 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y, bool loadOnlyMap /*=
     int gy = (int)(32 - y / SIZE_OF_GRIDS);                 // grid y
 
     // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[gx][gy];
+    GridMap* pMap = m_GridMaps[gx][gy].load(std::memory_order_acquire);
     if (!pMap || (!pMap->IsFullyLoaded() && !loadOnlyMap))
         pMap = LoadMapAndVMap(gx, gy, loadOnlyMap);
 
     return pMap;
 }
 
+std::string TerrainInfo::GetGridMapFileName(const uint32 x, const uint32 y) const
+{
+    // map file name
+    char fileName[24];
+    snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", m_mapId, x, y);
+    return sWorld.GetDataPath() + fileName;
+}
+
+bool TerrainInfo::IsGridPreloadNeeded(const uint32 x, const uint32 y)
+{
+    // called by the preloader threads, CleanUpGrids may free the grid meanwhile
+    LOCK_GUARD lock(m_mutex);
+    GridMap const* map = m_GridMaps[x][y].load(std::memory_order_relaxed);
+    return !map || !map->IsFullyLoaded();
+}
+
+void TerrainInfo::Preload(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    bool loaded;
+    {
+        LOCK_GUARD lock(m_mutex);
+        loaded = m_GridMaps[x][y].load(std::memory_order_relaxed) != nullptr;
+    }
+
+    if (!loaded)
+    {
+        // read outside of the lock, load errors are reported when a map loads the grid
+        GridMap* map = new GridMap();
+        if (map->loadData(GetGridMapFileName(x, y).c_str(), sWorld.getConfig(CONFIG_BOOL_GRIDMAP_MEMORY_MAPPED)))
+        {
+            LOCK_GUARD lock(m_mutex);
+            if (!m_GridMaps[x][y].load(std::memory_order_relaxed))
+            {
+                m_GridMaps[x][y].store(map, std::memory_order_release);
+                map = nullptr;
+            }
+        }
+
+        delete map;
+    }
+
+    // vmap tiles are linked into the model tree of the map, which can't change while other threads query it,
+    // so only the navmesh tile is read ahead, the map thread adds it to the navmesh
+    MMAP::MMapFactory::createOrGetMMapManager()->preloadTile(m_mapId, x, y);
+}
+
 GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly /*= false*/)
 {
-    if ((m_GridMaps[x][y] && mapOnly)
+    GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
+    if ((pMap && mapOnly)
         || (VMAP::VMapFactory::createOrGetVMapManager()->IsTileLoaded(m_mapId, x, y) && MMAP::MMapFactory::createOrGetMMapManager()->IsMMapIsLoaded(m_mapId, x, y)))
     {
         // nothing to load here
-        return m_GridMaps[x][y];
+        return pMap;
     }
 
     {
         LOCK_GUARD lock(m_mutex);
         // double checked lock pattern
-        if (!m_GridMaps[x][y])
+        pMap = m_GridMaps[x][y].load(std::memory_order_relaxed);
+        if (!pMap)
         {
             GridMap* map = new GridMap();
 
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+            std::string fileName = GetGridMapFileName(x, y);
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", fileName.c_str());
 
-            if (!map->loadData(tmp))
+            if (!map->loadData(fileName.c_str(), sWorld.getConfig(CONFIG_BOOL_GRIDMAP_MEMORY_MAPPED)))
             {
-                sLog.outError("Error load map file: %s", tmp);
+                sLog.outError("Error load map file: %s", fileName.c_str());
                 //assert(false);
             }
 
-            delete[] tmp;
-            m_GridMaps[x][y] = map;
+            m_GridMaps[x][y].store(map, std::memory_order_release);
+            pMap = map;
         }
     }
 
     // we'll load the rest later
     if (mapOnly)
-        return m_GridMaps[x][y];
+        return pMap;
 
     if (!VMAP::VMapFactory::createOrGetVMapManager()->IsTileLoaded(m_mapId, x, y))
     {
@@ -1279,10 +1444,9 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         MMAP::MMapFactory::createOrGetMMapManager()->loadMap(m_mapId, x, y);
     }
 
-    if (m_GridMaps[x][y])
-        m_GridMaps[x][y]->SetFullyLoaded();
+    pMap->SetFullyLoaded();
 
-    return  m_GridMaps[x][y];
+    return pMap;
 }
 
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= nullptr*/) const
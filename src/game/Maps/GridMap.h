@@ -24,8 +24,10 @@
 #include "Maps/GridDefines.h"
 
 #include "Maps/GridMapDefines.h"
+#include "MappedFile.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 
 class Creature;
@@ -76,12 +78,19 @@ class GridMap
         uint16* m_holes;
 
         // For fast check
-        bool m_fullyLoaded;
-
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        std::atomic<bool> m_fullyLoaded;
+
+        // set if the file is memory mapped, arrays inside the mapping are not owned
+        std::unique_ptr<MappedFile> m_file;
+
+        bool loadAreaData(uint8 const* data, uint32 dataSize, uint32 offset);
+        bool loadHeightData(uint8 const* data, uint32 dataSize, uint32 offset);
+        bool loadGridMapLiquidData(uint8 const* data, uint32 dataSize, uint32 offset);
+        bool loadHolesData(uint8 const* data, uint32 dataSize, uint32 offset);
+        template<typename T>
+        bool loadArray(T*& array, uint32 count, uint8 const* data, uint32 dataSize, uint32& offset);
+        template<typename T>
+        void freeArray(T*& array);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -97,16 +106,19 @@ class GridMap
         GridMap();
         ~GridMap();
 
-        bool loadData(char const* filename);
+        // mapped files share their pages with every process using the same data directory
+        bool loadData(char const* filename, bool mapped = false);
         void unloadData();
-        bool IsFullyLoaded() const { return m_fullyLoaded; }
-        void SetFullyLoaded() { m_fullyLoaded = true; }
+        bool IsFullyLoaded() const { return m_fullyLoaded.load(std::memory_order_acquire); }
+        void SetFullyLoaded() { m_fullyLoaded.store(true, std::memory_order_release); }
 
         static bool ExistMap(uint32 mapid, int gx, int gy);
         static bool ExistVMap(uint32 mapid, int gx, int gy);
 
         uint16 getArea(float x, float y) const;
         inline float getHeight(float x, float y) const { return (this->*m_gridGetHeight)(x, y); }
+        // heights of count points inside this grid, the storage format is resolved once per call
+        void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float getLiquidLevel(float x, float y) const;
         uint8 getTerrainType(float x, float y) const;
         GridMapLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data = nullptr);
@@ -148,6 +160,9 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool useVmaps = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // same for count points, z holds the search heights and receives the results
+        // consecutive points in the same grid are sampled together, so callers should pass them sorted by area
+        void GetHeightStatic(float const* x, float const* y, float* z, uint32 count, bool useVmaps = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = nullptr) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = nullptr, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = nullptr, float min_depth = 2.0f) const;
@@ -173,6 +188,11 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
         void CleanUpGrids(const uint32 diff);
 
+        // reads the terrain and navmesh files of a grid before a map needs it, see GridPreloader
+        // the grid stays unreferenced and is cleaned up if nobody loads it soon
+        bool IsGridPreloadNeeded(const uint32 x, const uint32 y);
+        void Preload(const uint32 x, const uint32 y);
+
     protected:
         friend class Map;
         friend class ObjectMgr;
@@ -185,14 +205,17 @@ class TerrainInfo : public Referencable<std::atomic_long>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y, bool loadOnlyMap = false);
+        float SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly = false);
+        std::string GetGridMapFileName(const uint32 x, const uint32 y) const;
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
 
         const uint32 m_mapId;
 
-        GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        // written under m_mutex, read without it by the map threads
+        std::atomic<GridMap*> m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         // global garbage collection timer
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/GridPreloader.h"
+#include "Maps/GridMap.h"
+
+#define MAX_QUEUED_GRID_PRELOADS 32
+
+void GridPreloader::Activate(uint32 threads)
+{
+    m_stop = false;
+    for (uint32 i = 0; i < threads; ++i)
+        m_threads.emplace_back(&GridPreloader::WorkerThread, this);
+}
+
+void GridPreloader::Deactivate()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_requestAdded.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+
+    // drop what was not started
+    for (PreloadRequest const& request : m_requests)
+        request.terrain->Release();
+    m_requests.clear();
+    m_queued.clear();
+}
+
+void GridPreloader::Request(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_stop || m_requests.size() >= MAX_QUEUED_GRID_PRELOADS)
+            return;
+
+        if (!m_queued.insert(MakeKey(terrain->GetMapId(), x, y)).second)
+            return;
+
+        // keeps the terrain alive until the request is done
+        terrain->AddRef();
+
+        PreloadRequest request;
+        request.terrain = terrain;
+        request.x = x;
+        request.y = y;
+        m_requests.push_back(request);
+    }
+    m_requestAdded.notify_one();
+}
+
+void GridPreloader::WorkerThread()
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (true)
+    {
+        m_requestAdded.wait(guard, [this]() { return m_stop || !m_requests.empty(); });
+        if (m_stop)
+            return;
+
+        PreloadRequest request = m_requests.front();
+        m_requests.pop_front();
+
+        guard.unlock();
+
+        if (request.terrain->IsGridPreloadNeeded(request.x, request.y))
+            request.terrain->Preload(request.x, request.y);
+
+        // an unreferenced terrain is not freed here, its destructor unloads the vmaps and mmaps
+        // which only the map threads may do. TerrainManager keeps it for the next map of that id.
+        uint32 mapId = request.terrain->GetMapId();
+        request.terrain->Release();
+
+        guard.lock();
+        m_queued.erase(MakeKey(mapId, request.x, request.y));
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _GRID_PRELOADER_H_INCLUDED
+#define _GRID_PRELOADER_H_INCLUDED
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+class TerrainInfo;
+
+/**
+ * Reads the terrain and navmesh files of grids that players are about to enter on
+ * background threads, so the map thread only links them when the grid is loaded.
+ *
+ * Maps request grids along the predicted path of their moving players, see
+ * Map::PreloadGridsAhead. Creature and gameobject spawns are still created by the
+ * map thread, they belong to the map.
+ */
+class GridPreloader
+{
+    public:
+        GridPreloader() : m_stop(false) {}
+        ~GridPreloader() { Deactivate(); }
+
+        void Activate(uint32 threads);
+        void Deactivate();
+        bool IsActive() const { return !m_threads.empty(); }
+
+        // ignored if the grid is already queued or too many grids are waiting
+        void Request(TerrainInfo* terrain, uint32 x, uint32 y);
+
+    private:
+        struct PreloadRequest
+        {
+            TerrainInfo* terrain;
+            uint32 x;
+            uint32 y;
+        };
+
+        static uint64 MakeKey(uint32 mapId, uint32 x, uint32 y) { return (uint64(mapId) << 32) | (x << 16) | y; }
+
+        void WorkerThread();
+
+        std::mutex m_lock;
+        std::condition_variable m_requestAdded;
+        std::deque<PreloadRequest> m_requests;
+        std::set<uint64> m_queued;                          // also holds the requests in progress
+        std::vector<std::thread> m_threads;
+        bool m_stop;
+};
+
+#endif
@@ -39,11 +39,24 @@
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "Grids/ObjectGridLoader.h"
+#include "Maps/MapWorkers.h"
+
+namespace
+{
+    // map whose partition the current thread is updating, nullptr outside of partitioned updates
+    thread_local Map* tl_partitionMap = nullptr;
+    // the current thread holds the partition lock of tl_partitionMap until its current object is updated
+    thread_local bool tl_serialSection = false;
+}
 
 Map::~Map()
 {
     UnloadAll(true);
 
+    // path finders of units that were not removed by UnloadAll
+    while (!m_pathRequests.empty())
+        m_pathRequests.back()->cancelAsync();
+
     if (!m_scriptSchedule.empty())
         sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
@@ -92,10 +105,12 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
-      m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_activeNonPlayersIter(m_activeNonPlayers.end()), m_partitionedUpdate(false),
+      m_onEventNotifiedIter(m_onEventNotifiedObjects.end()), i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), i_defaultLight(GetDefaultMapLight(id)),
-      m_cycleCounter(0), m_updateTimeMin(INT_MAX), m_updateTimeMax(0), m_updateTimeTotal(0)
+      m_cycleCounter(0), m_updateTimeMin(INT_MAX), m_updateTimeMax(0), m_updateTimeTotal(0), m_updateCost(0),
+      m_partitionedCycles(0), m_partitionCountTotal(0), m_partitionWorkTime(0), m_partitionWallTime(0),
+      m_gridPreloadTimer(0)
 {
     m_weatherSystem = new WeatherSystem(this);
 }
@@ -368,6 +383,8 @@ Map::Add(T* obj)
 {
     MANGOS_ASSERT(obj);
 
+    PartitionMutationGuard guard(*this);
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -488,25 +505,28 @@ void Map::MessageDistBroadcast(WorldObject const* obj, WorldPacket const& msg, f
 
 void Map::MessageMapBroadcast(WorldObject const* /*obj*/, WorldPacket const& msg)
 {
+    MaNGOS::BroadcastPacket packet(msg);
     Map::PlayerList const& pList = GetPlayers();
     for (const auto& itr : pList)
-        itr.getSource()->SendDirectMessage(msg);
+        packet.SendTo(itr.getSource()->GetSession());
 }
 
 void Map::MessageMapBroadcastZone(WorldObject const* /*obj*/, WorldPacket const& msg, uint32 zoneId)
 {
+    MaNGOS::BroadcastPacket packet(msg);
     Map::PlayerList const& pList = GetPlayers();
     for (const auto& itr : pList)
         if (itr.getSource()->GetZoneId() == zoneId)
-            itr.getSource()->SendDirectMessage(msg);
+            packet.SendTo(itr.getSource()->GetSession());
 }
 
 void Map::MessageMapBroadcastArea(WorldObject const* /*obj*/, WorldPacket const& msg, uint32 areaId)
 {
+    MaNGOS::BroadcastPacket packet(msg);
     Map::PlayerList const& pList = GetPlayers();
     for (const auto& itr : pList)
         if (itr.getSource()->GetAreaId() == areaId)
-            itr.getSource()->SendDirectMessage(msg);
+            packet.SendTo(itr.getSource()->GetSession());
 }
 
 void Map::ExecuteDistWorker(WorldObject const* obj, float dist, std::function<void(Player*)> const& worker)
@@ -583,6 +603,337 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
     }
 }
 
+void Map::MarkNearbyCellsOf(WorldObject* obj, std::vector<uint32>& cells)
+{
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (!isCellMarked(cell_id))
+            {
+                markCell(cell_id);
+                cells.push_back(cell_id);
+            }
+        }
+    }
+}
+
+void Map::BuildPartitions(std::vector<uint32> const& cells, std::vector<MapPartition>& partitions, std::unordered_map<uint32, uint32>& cellPartition) const
+{
+    // Two marked cells belong to the same partition if an object in one of them can reach (see, cast at, relocate
+    // next to) an object of the other one. Objects interact at most at visibility distance, so cells further apart
+    // than twice that distance can never touch the same grid data.
+    int32 const reach = int32(ceil(GetVisibilityDistance() / SIZE_OF_GRID_CELL));
+    int32 const gap = 2 * reach + 1;
+
+    cellPartition.reserve(cells.size());
+
+    std::vector<uint32> stack;
+    for (uint32 start : cells)
+    {
+        if (cellPartition.find(start) != cellPartition.end())
+            continue;
+
+        uint32 partitionId = partitions.size();
+        partitions.emplace_back(partitionId);
+        MapPartition& partition = partitions.back();
+
+        // flood fill over all marked cells in range
+        cellPartition[start] = partitionId;
+        stack.push_back(start);
+        while (!stack.empty())
+        {
+            uint32 cell_id = stack.back();
+            stack.pop_back();
+            partition.cells.push_back(cell_id);
+
+            int32 cx = cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP;
+            int32 cy = cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP;
+            for (int32 x = std::max(0, cx - gap); x <= std::min(int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1, cx + gap); ++x)
+            {
+                for (int32 y = std::max(0, cy - gap); y <= std::min(int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1, cy + gap); ++y)
+                {
+                    uint32 neighbour = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                    if (!isCellMarked(neighbour) || cellPartition.find(neighbour) != cellPartition.end())
+                        continue;
+
+                    cellPartition[neighbour] = partitionId;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+    }
+}
+
+void Map::EnterSerialSection()
+{
+    if (!tl_partitionMap || tl_serialSection)
+        return;
+
+    tl_partitionMap->m_partitionMutationLock.lock();
+    tl_serialSection = true;
+}
+
+void Map::LeaveSerialSection()
+{
+    if (!tl_serialSection)
+        return;
+
+    tl_serialSection = false;
+    tl_partitionMap->m_partitionMutationLock.unlock();
+}
+
+bool Map::IsPartitionLocal(WorldObject* object, uint32 partitionId, std::unordered_map<uint32, uint32> const& cellPartition)
+{
+    // scripts keep pointers to the instance data (also world maps have one), they can't be caught when using it
+    if (i_data)
+    {
+        if (object->GetTypeId() == TYPEID_UNIT && static_cast<Creature*>(object)->GetScriptId())
+            return false;
+        if (object->GetTypeId() == TYPEID_GAMEOBJECT && static_cast<GameObject*>(object)->GetScriptId())
+            return false;
+    }
+
+    auto inPartition = [&](WorldObject* other)
+    {
+        if (!other)
+            return true;
+
+        if (!other->IsInWorld() || other->GetMap() != this)
+            return false;
+
+        CellPair pair = MaNGOS::ComputeCellPair(other->GetPositionX(), other->GetPositionY());
+        auto itr = cellPartition.find(pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + pair.x_coord);
+        return itr != cellPartition.end() && itr->second == partitionId;
+    };
+    auto guidInPartition = [&](ObjectGuid const& guid)
+    {
+        return guid.IsEmpty() || guid == object->GetObjectGuid() || inPartition(GetWorldObject(guid));
+    };
+
+    if (!guidInPartition(object->GetOwnerGuid()))
+        return false;
+
+    if (object->GetTypeId() != TYPEID_UNIT)
+        return true;
+
+    // objects related to this one are touched without a lookup, they must be updated by the same thread
+    Unit* unit = static_cast<Unit*>(object);
+    if (!guidInPartition(unit->GetMasterGuid()) || !inPartition(unit->GetCharm()) ||
+        !guidInPartition(unit->GetPetGuid()) || !guidInPartition(unit->GetSpawnerGuid()) ||
+        !inPartition(unit->getVictim()))
+        return false;
+
+    for (uint32 slot = 0; slot < MAX_TOTEM_SLOT; ++slot)
+        if (!guidInPartition(unit->GetTotemGuid(TotemSlot(slot))))
+            return false;
+
+    for (HostileReference* ref : unit->getThreatManager().getThreatList())
+        if (!inPartition(ref->getTarget()))
+            return false;
+
+    for (HostileReference* ref = unit->getHostileRefManager().getFirst(); ref; ref = ref->next())
+        if (!inPartition(ref->getSource()->getOwner()))
+            return false;
+
+    for (auto& itr : unit->GetSpellAuraHolderMap())
+        if (!guidInPartition(itr.second->GetCasterGuid()))
+            return false;
+
+    return true;
+}
+
+void Map::UpdateObjectsPartitioned(MapUpdater& updater, std::vector<MapPartition>& partitions, std::vector<WorldObject*> const& serialObjects, uint32 diff)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    m_partitionedUpdate = true;
+
+    // the map thread takes part as well, it starts with the biggest partition
+    updater.run_shares(partitions.size(), [this, &partitions, diff](size_t index)
+    {
+        MapPartition& partition = partitions[index];
+        std::chrono::steady_clock::time_point partitionStart = std::chrono::steady_clock::now();
+
+        tl_partitionMap = this;
+        for (WorldObject* object : partition.objects)
+        {
+            object->Update(diff);
+            LeaveSerialSection();
+        }
+        tl_partitionMap = nullptr;
+
+        partition.updateTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - partitionStart).count();
+    });
+
+    m_partitionedUpdate = false;
+
+    // objects reaching into other partitions are updated alone, before any deferred change is applied
+    std::chrono::steady_clock::time_point serialStart = std::chrono::steady_clock::now();
+    for (WorldObject* object : serialObjects)
+        object->Update(diff);
+    uint64 workTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - serialStart).count();
+
+    // mutation phase, apply the changes that were not safe to do while partitions were running
+    std::vector<std::function<void(Map*)>> mutations;
+    {
+        std::lock_guard<std::mutex> guard(m_deferredMutationLock);
+        std::swap(mutations, m_deferredMutations);
+    }
+
+    for (auto& mutation : mutations)
+        mutation(this);
+
+    for (MapPartition const& partition : partitions)
+        workTime += partition.updateTime;
+
+    ++m_partitionedCycles;
+    m_partitionCountTotal += partitions.size();
+    m_partitionWorkTime += workTime;
+    m_partitionWallTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Map::UpdateActiveCellsPartitioned(MapUpdater& updater, uint32 diff)
+{
+    // mark all active cells first, the marked area decides which cells are independent
+    std::vector<uint32> cells;
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        MarkNearbyCellsOf(player, cells);
+
+        // If player is using far sight, visit that object too
+        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+            MarkNearbyCellsOf(viewPoint, cells);
+    }
+
+    for (auto obj : m_activeNonPlayers)
+    {
+        if (obj->IsInWorld() && obj->IsPositionValid())
+            MarkNearbyCellsOf(obj, cells);
+    }
+
+    std::vector<MapPartition> partitions;
+    std::unordered_map<uint32, uint32> cellPartition;
+    BuildPartitions(cells, partitions, cellPartition);
+
+    // grid loading is not thread safe, so collecting the objects is done here for all partitions
+    size_t objectCount = 0;
+    for (auto& partition : partitions)
+    {
+        MaNGOS::ObjectUpdater obj_updater(partition.objects, diff);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);
+
+        for (uint32 cell_id : partition.cells)
+        {
+            CellPair pair(cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP, cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+            Cell cell(pair);
+            cell.SetNoCreate();
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+
+        objectCount += partition.objects.size();
+    }
+
+    std::sort(partitions.begin(), partitions.end(), [](MapPartition const & a, MapPartition const & b) { return a.objects.size() > b.objects.size(); });
+    while (!partitions.empty() && partitions.back().objects.empty())
+        partitions.pop_back();
+
+    if (partitions.size() > 1 && objectCount >= sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_PARTITION_MIN_OBJECTS))
+    {
+        std::vector<WorldObject*> serialObjects;
+        for (auto& partition : partitions)
+        {
+            for (auto itr = partition.objects.begin(); itr != partition.objects.end();)
+            {
+                if (IsPartitionLocal(*itr, partition.id, cellPartition))
+                    ++itr;
+                else
+                {
+                    serialObjects.push_back(*itr);
+                    itr = partition.objects.erase(itr);
+                }
+            }
+        }
+
+        UpdateObjectsPartitioned(updater, partitions, serialObjects, diff);
+    }
+    else
+    {
+        for (auto& partition : partitions)
+            for (auto wObj : partition.objects)
+                wObj->Update(diff);
+    }
+}
+
+#define GRID_PRELOAD_INTERVAL   1000
+#define GRID_PRELOAD_MAX_SPEED  60.0f                       // faster position changes are teleports, not movement
+
+void Map::PreloadGridsAhead(uint32 diff)
+{
+    GridPreloader* preloader = sMapMgr.GetGridPreloader();
+    if (!preloader)
+        return;
+
+    m_gridPreloadTimer += diff;
+    if (m_gridPreloadTimer < GRID_PRELOAD_INTERVAL)
+        return;
+
+    float elapsed = m_gridPreloadTimer / float(IN_MILLISECONDS);
+    float lookahead = float(sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD));
+    m_gridPreloadTimer = 0;
+
+    // positions are compared instead of movement flags, so taxis, transports and vehicles are predicted as well
+    std::unordered_map<ObjectGuid, std::pair<float, float>> positions;
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        float x = player->GetPositionX();
+        float y = player->GetPositionY();
+        positions[player->GetObjectGuid()] = std::make_pair(x, y);
+
+        auto last = m_gridPreloadPositions.find(player->GetObjectGuid());
+        if (last == m_gridPreloadPositions.end())
+            continue;
+
+        float speed = sqrt((x - last->second.first) * (x - last->second.first) + (y - last->second.second) * (y - last->second.second)) / elapsed;
+        if (speed < 1.0f || speed > GRID_PRELOAD_MAX_SPEED)
+            continue;
+
+        float dx = (x - last->second.first) / elapsed * lookahead;
+        float dy = (y - last->second.second) / elapsed * lookahead;
+
+        // sample every half grid so no grid crossed on the way is missed
+        uint32 steps = uint32(speed * lookahead / (SIZE_OF_GRIDS / 2)) + 1;
+        for (uint32 i = 1; i <= steps; ++i)
+        {
+            float px = x + dx * i / steps;
+            float py = y + dy * i / steps;
+            if (!MaNGOS::IsValidMapCoord(px, py))
+                break;
+
+            GridPair p = MaNGOS::ComputeGridPair(px, py);
+            uint32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+            uint32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+            if (m_TerrainData->IsGridPreloadNeeded(gx, gy))
+                preloader->Request(m_TerrainData, gx, gy);
+        }
+    }
+
+    m_gridPreloadPositions.swap(positions);
+}
+
 void Map::Update(const uint32& t_diff)
 {
     std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
@@ -610,6 +961,8 @@ void Map::Update(const uint32& t_diff)
             plr->Update(t_diff);
     }
 
+    PreloadGridsAhead(t_diff);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -621,68 +974,77 @@ void Map::Update(const uint32& t_diff)
         m_messageVector.clear();
     }
 
-    WorldObjectUnSet objToUpdate;
-    MaNGOS::ObjectUpdater obj_updater(objToUpdate, t_diff);
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
-
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    // battleground state is used by every object of the map, so those are never partitioned
+    MapUpdater* updater = sWorld.getConfig(CONFIG_BOOL_MAP_UPDATE_PARTITIONED) && !IsBattleGroundOrArena() ? sMapMgr.GetMapUpdater() : nullptr;
+    if (updater)
+        UpdateActiveCellsPartitioned(*updater, t_diff);
+    else
     {
-        Player* player = m_mapRefIter->getSource();
-        if (!player->IsInWorld() || !player->IsPositionValid())
-            continue;
+        WorldObjectUnSet objToUpdate;
+        MaNGOS::ObjectUpdater obj_updater(objToUpdate, t_diff);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
+            if (!player->IsInWorld() || !player->IsPositionValid())
+                continue;
 
-        // If player is using far sight, visit that object too
-        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
-    }
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
-    {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            // If player is using far sight, visit that object too
+            if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+                VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        }
+
+        // non-player active objects
+        if (!m_activeNonPlayers.empty())
         {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
+            for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            {
+                // skip not in world
+                WorldObject* obj = *m_activeNonPlayersIter;
 
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
+                // step before processing, in this case if Map::Remove remove next object we correctly
+                // step to next-next, and if we step to end() then newly added objects can wait next update.
+                ++m_activeNonPlayersIter;
 
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
+                if (!obj->IsInWorld() || !obj->IsPositionValid())
+                    continue;
 
-            // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+                // lets update mobs/objects in ALL visible cells around player!
+                CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
 
-            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-            {
-                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
                 {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
+                    for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
                     {
-                        markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
+                        // marked cells are those that have been visited
+                        // don't visit the same cell twice
+                        uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                        if (!isCellMarked(cell_id))
+                        {
+                            markCell(cell_id);
+                            CellPair pair(x, y);
+                            Cell cell(pair);
+                            cell.SetNoCreate();
+                            Visit(cell, grid_object_update);
+                            Visit(cell, world_object_update);
+                        }
                     }
                 }
             }
         }
+
+        // update all objects
+        for (auto wObj : objToUpdate)
+            wObj->Update(t_diff);
     }
 
-    // update all objects
-    for (auto wObj : objToUpdate)
-        wObj->Update(t_diff);
+    CalculatePathRequests();
 
     // Send world objects and item update field changes
     SendObjectUpdates();
@@ -720,6 +1082,10 @@ void Map::Update(const uint32& t_diff)
     m_updateTimeTotal += duration;
     ++m_cycleCounter;
 
+    // moving average of the update cost, used to order map updates
+    uint32 cost = uint32(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    m_updateCost = m_updateCost - m_updateCost / MAP_UPDATE_COST_SMOOTHING + cost / MAP_UPDATE_COST_SMOOTHING;
+
     m_weatherSystem->UpdateWeathers(t_diff);
 }
 
@@ -779,6 +1145,8 @@ template<class T>
 void
 Map::Remove(T* obj, bool remove)
 {
+    PartitionMutationGuard guard(*this);
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -822,6 +1190,8 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
 {
     MANGOS_ASSERT(player);
 
+    PartitionMutationGuard guard(*this);
+
     CellPair old_val = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     CellPair new_val = MaNGOS::ComputeCellPair(x, y);
 
@@ -858,6 +1228,8 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
 
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
 {
+    PartitionMutationGuard guard(*this);
+
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
     // do move or do move to respawn or remove creature if previous all fail
@@ -1109,6 +1481,12 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
 
 void Map::AddObjectToRemoveList(WorldObject* obj)
 {
+    if (m_partitionedUpdate)
+    {
+        DeferMutation([obj](Map * map) { map->AddObjectToRemoveList(obj); });
+        return;
+    }
+
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
@@ -1226,6 +1604,8 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    PartitionMutationGuard guard(*this);
+
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
@@ -1254,6 +1634,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    PartitionMutationGuard guard(*this);
+
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -1778,6 +2160,8 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
 {
     MANGOS_ASSERT(source);
 
+    EnterSerialSection();
+
     ///- Find the script map
     ScriptMapMap::const_iterator s = scripts.second.find(id);
     if (s == scripts.second.end())
@@ -1894,6 +2278,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    PartitionMutationGuard guard(*this);
     return m_objectsStore.find<Creature>(guid, (Creature*)nullptr);
 }
 
@@ -1904,6 +2289,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    PartitionMutationGuard guard(*this);
     return m_objectsStore.find<Pet>(guid, (Pet*)nullptr);
 }
 
@@ -1945,6 +2331,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    PartitionMutationGuard guard(*this);
     return m_objectsStore.find<GameObject>(guid, (GameObject*)nullptr);
 }
 
@@ -1955,6 +2342,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    PartitionMutationGuard guard(*this);
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)nullptr);
 }
 
@@ -2003,22 +2391,109 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    if (i_objectsToClientUpdate.empty())
+        return;
 
-    while (!i_objectsToClientUpdate.empty())
+    // building the updates clears the changed state of the objects, none of them is added again meanwhile
+    std::vector<Object*> objects;
+    std::swap(objects, i_objectsToClientUpdate);
+
+    MapUpdater* updater = sWorld.getConfig(CONFIG_BOOL_OBJECT_UPDATE_PARALLEL) ? sMapMgr.GetMapUpdater() : nullptr;
+    if (updater && objects.size() >= sWorld.getConfig(CONFIG_UINT32_OBJECT_UPDATE_PARALLEL_MIN_OBJECTS))
+        SendObjectUpdatesParallel(*updater, objects);
+    else
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+        UpdateDataMapType update_players;
+
+        for (Object* obj : objects)
+            obj->BuildUpdateData(update_players);
+
+        WorldPacket packet;                                 // here we allocate a std::vector with a size of 0x10000
+        for (auto& update_player : update_players)
+        {
+            update_player.second.BuildPacket(packet);
+            update_player.first->GetSession()->SendPacket(packet);
+            packet.clear();                                 // clean the string
+        }
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (auto& update_player : update_players)
+    // keep the allocated list for the next tick
+    objects.clear();
+    if (i_objectsToClientUpdate.empty())
+        std::swap(objects, i_objectsToClientUpdate);
+}
+
+void Map::SendObjectUpdatesParallel(MapUpdater& updater, std::vector<Object*> const& objects)
+{
+    // one share of the objects for each map update thread and one for this thread
+    size_t shareCount = std::min<size_t>(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS) + 1, objects.size());
+    size_t shareSize = (objects.size() + shareCount - 1) / shareCount;
+    shareCount = (objects.size() + shareSize - 1) / shareSize;
+
+    std::vector<UpdateDataMapType> updates(shareCount);
+    updater.run_shares(shareCount, [&objects, &updates, shareSize](size_t index)
     {
-        update_player.second.BuildPacket(packet);
-        update_player.first->GetSession()->SendPacket(packet);
-        packet.clear();                                     // clean the string
+        size_t last = std::min((index + 1) * shareSize, objects.size());
+        for (size_t i = index * shareSize; i < last; ++i)
+            objects[i]->BuildUpdateData(updates[index]);
+    });
+
+    // a player may have got blocks from several shares
+    std::vector<ObjectUpdateReceiver> receivers;
+    std::unordered_map<Player*, size_t> receiverIndex;
+    for (UpdateDataMapType& share : updates)
+    {
+        for (auto& update_player : share)
+        {
+            auto itr = receiverIndex.find(update_player.first);
+            if (itr == receiverIndex.end())
+            {
+                receiverIndex.emplace(update_player.first, receivers.size());
+                receivers.emplace_back(update_player.first, std::vector<UpdateData*>(1, &update_player.second));
+            }
+            else
+                receivers[itr->second].second.push_back(&update_player.second);
+        }
     }
+
+    if (receivers.empty())
+        return;
+
+    // packets are built, compressed and sent in shares of receivers the same way
+    shareCount = std::min<size_t>(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS) + 1, receivers.size());
+    shareSize = (receivers.size() + shareCount - 1) / shareCount;
+    shareCount = (receivers.size() + shareSize - 1) / shareSize;
+
+    updater.run_shares(shareCount, [&receivers, shareSize](size_t index)
+    {
+        WorldPacket packet;
+        size_t last = std::min((index + 1) * shareSize, receivers.size());
+        for (size_t i = index * shareSize; i < last; ++i)
+        {
+            std::vector<UpdateData*>& parts = receivers[i].second;
+            for (size_t j = 1; j < parts.size(); ++j)
+                parts[0]->Append(*parts[j]);
+
+            parts[0]->BuildPacket(packet);
+            receivers[i].first->GetSession()->SendPacket(packet);
+            packet.clear();
+        }
+    });
+}
+
+void Map::AddTempCreature(uint32 entry, bool pet)
+{
+    PartitionMutationGuard guard(*this);
+    ++(pet ? m_tempPets : m_tempCreatures)[entry];
+}
+
+void Map::RemoveTempCreature(uint32 entry, bool pet)
+{
+    PartitionMutationGuard guard(*this);
+    std::map<uint32, uint32>& counts = pet ? m_tempPets : m_tempCreatures;
+    auto itr = counts.find(entry);
+    if (itr != counts.end() && --itr->second == 0)
+        counts.erase(itr);
 }
 
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
@@ -2241,6 +2716,19 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
     return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight, phasemask));
 }
 
+void Map::GetHeights(uint32 phasemask, float const* x, float const* y, float* z, uint32 count) const
+{
+    // the static heights of points in the same grid are sampled together
+    std::vector<float> staticHeights(z, z + count);
+    m_TerrainData->GetHeightStatic(x, y, staticHeights.data(), count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float dynSearchHeight = 2.0f + (z[i] < staticHeights[i] ? staticHeights[i] : z[i]);
+        z[i] = std::max<float>(staticHeights[i], m_dyn_tree.getHeight(x[i], y[i], dynSearchHeight, dynSearchHeight - staticHeights[i], phasemask));
+    }
+}
+
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
@@ -2426,12 +2914,67 @@ bool Map::GetReachableRandomPosition(Unit* unit, float& x, float& y, float& z, f
     return false;
 }
 
+void Map::AddPathRequest(PathFinder* path)
+{
+    std::lock_guard<std::mutex> guard(m_pathRequestLock);
+    m_pathRequests.push_back(path);
+}
+
+void Map::RemovePathRequest(PathFinder* path)
+{
+    std::lock_guard<std::mutex> guard(m_pathRequestLock);
+    auto itr = std::find(m_pathRequests.begin(), m_pathRequests.end(), path);
+    if (itr != m_pathRequests.end())
+    {
+        *itr = m_pathRequests.back();
+        m_pathRequests.pop_back();
+    }
+}
+
+void Map::CalculatePathRequests()
+{
+    std::vector<PathFinder*> paths;
+    {
+        std::lock_guard<std::mutex> guard(m_pathRequestLock);
+        std::swap(paths, m_pathRequests);
+    }
+
+    if (paths.empty())
+        return;
+
+    // no object of this map changes until all paths are done, so they only read units and terrain
+    MapUpdater* updater = sMapMgr.GetMapUpdater();
+    if (!updater)
+    {
+        for (PathFinder* path : paths)
+            path->calculatePending();
+        return;
+    }
+
+    size_t shareCount = std::min<size_t>(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS) + 1, paths.size());
+    size_t shareSize = (paths.size() + shareCount - 1) / shareCount;
+    shareCount = (paths.size() + shareSize - 1) / shareSize;
+
+    updater->run_shares(shareCount, [&paths, shareSize](size_t index)
+    {
+        size_t last = std::min((index + 1) * shareSize, paths.size());
+        for (size_t i = index * shareSize; i < last; ++i)
+            paths[i]->calculatePending();
+    });
+}
+
 void Map::AddMessage(const std::function<void(Map*)>& message)
 {
     std::lock_guard<std::mutex> guard(m_messageMutex);
     m_messageVector.push_back(message);
 }
 
+void Map::DeferMutation(const std::function<void(Map*)>& mutation)
+{
+    std::lock_guard<std::mutex> guard(m_deferredMutationLock);
+    m_deferredMutations.push_back(mutation);
+}
+
 bool Map::IsMountAllowed() const
 {
     if (!IsDungeon())
@@ -2460,11 +3003,13 @@ uint32 Map::SpawnedCountForEntry(uint32 entry)
 
 void Map::AddToSpawnCount(const ObjectGuid& guid)
 {
+    PartitionMutationGuard guard(*this);
     m_spawnedCount[guid.GetEntry()].insert(guid);
 }
 
 void Map::RemoveFromSpawnCount(const ObjectGuid& guid)
 {
+    PartitionMutationGuard guard(*this);
     m_spawnedCount[guid.GetEntry()].erase(guid);
 }
 
@@ -35,6 +35,7 @@
 #include "Entities/CreatureLinkingMgr.h"
 #include "Vmap/DynamicTree.h"
 
+#include <algorithm>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -54,6 +55,9 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+class MapUpdater;
+class PathFinder;
+struct MapPartition;
 namespace MaNGOS { struct ObjectUpdater; }
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
@@ -104,6 +108,7 @@ struct ZoneDynamicInfo
 #endif
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define MAP_UPDATE_COST_SMOOTHING 8                         // weight of older samples in the map update cost average
 
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 
@@ -222,7 +227,7 @@ class Map : public GridRefManager<NGridType>
         bool IsMountAllowed() const;
 
         // can't be nullptr for loaded map
-        MapPersistentState* GetPersistentState() const { return m_persistentState; }
+        MapPersistentState* GetPersistentState() const { EnterSerialSection(); return m_persistentState; }
 
         void AddObjectToRemoveList(WorldObject* obj);
 
@@ -277,20 +282,53 @@ class Map : public GridRefManager<NGridType>
         WorldObject* GetWorldObject(ObjectGuid guid);       // only use if sure that need objects at current map, specially for player case
 
         typedef TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid> MapStoredObjectTypesContainer;
-        MapStoredObjectTypesContainer& GetObjectsStore() { return m_objectsStore; }
-        std::map<uint32, uint32>& GetTempCreatures() { return m_tempCreatures; }
-        std::map<uint32, uint32>& GetTempPets() { return m_tempPets; }
+        // objects found by guid, changes are serialized while partitions are updated concurrently
+        template<class T> void InsertObject(ObjectGuid guid, T* object) { PartitionMutationGuard guard(*this); m_objectsStore.insert<T>(guid, object); }
+        template<class T> void EraseObject(ObjectGuid guid) { PartitionMutationGuard guard(*this); m_objectsStore.erase<T>(guid, (T*)nullptr); }
+        std::map<uint32, uint32> const& GetTempCreatures() const { return m_tempCreatures; }
+        std::map<uint32, uint32> const& GetTempPets() const { return m_tempPets; }
+        void AddTempCreature(uint32 entry, bool pet);
+        void RemoveTempCreature(uint32 entry, bool pet);
 
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            std::unique_lock<std::mutex> guard(m_clientUpdateLock, std::defer_lock);
+            if (m_partitionedUpdate)
+                guard.lock();
+
+            obj->SetClientUpdateIndex(i_objectsToClientUpdate.size());
+            i_objectsToClientUpdate.push_back(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            std::unique_lock<std::mutex> guard(m_clientUpdateLock, std::defer_lock);
+            if (m_partitionedUpdate)
+                guard.lock();
+
+            // the index is stale once the list was handed over to SendObjectUpdates
+            size_t index = obj->GetClientUpdateIndex();
+            if (index < i_objectsToClientUpdate.size() && i_objectsToClientUpdate[index] == obj)
+            {
+                Object* last = i_objectsToClientUpdate.back();
+                i_objectsToClientUpdate[index] = last;
+                last->SetClientUpdateIndex(index);
+                i_objectsToClientUpdate.pop_back();
+            }
         }
 
+        // true while objects of this map are updated concurrently in several partitions
+        bool IsPartitionedUpdate() const { return m_partitionedUpdate; }
+        // called before map or world wide state is used from an object update, in a partitioned update the
+        // calling partition then runs alone until the update of its current object is done
+        static void EnterSerialSection();
+        // queue a change that may affect other partitions, it is executed once all partitions are updated
+        void DeferMutation(const std::function<void(Map*)>& mutation);
+
+        // paths queued by PathFinder::calculateAsync, calculated after the object updates of each tick
+        void AddPathRequest(PathFinder* path);
+        void RemovePathRequest(PathFinder* path);
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -298,7 +336,7 @@ class Map : public GridRefManager<NGridType>
         const TerrainInfo* GetTerrain() const { return m_TerrainData; }
 
         void CreateInstanceData(bool load);
-        InstanceData* GetInstanceData() const { return i_data; }
+        InstanceData* GetInstanceData() const { EnterSerialSection(); return i_data; }
         uint32 GetScriptId() const { return i_script_id; }
 
         void MonsterYellToMap(ObjectGuid guid, int32 textId, ChatMsg chatMsg, Language language, Unit const* target) const;
@@ -307,6 +345,7 @@ class Map : public GridRefManager<NGridType>
 
         // Dynamic VMaps
         float GetHeight(uint32 phasemask, float x, float y, float z) const;
+        void GetHeights(uint32 phasemask, float const* x, float const* y, float* z, uint32 count) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
@@ -317,7 +356,7 @@ class Map : public GridRefManager<NGridType>
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
 
         // Get Holder for Creature Linking
-        CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
+        CreatureLinkingHolder* GetCreatureLinkingHolder() { EnterSerialSection(); return &m_creatureLinkingHolder; }
 
         // Teleport all players in that map to choosed location
         void TeleportAllPlayersTo(TeleportLocation loc);
@@ -347,6 +386,13 @@ class Map : public GridRefManager<NGridType>
         uint32 GetUpdateTimeMin() { return m_updateTimeMin; }
         uint32 GetUpdateTimeMax() { return m_updateTimeMax; }
         uint32 GetUpdateTimeAvg() { return uint32(m_updateTimeTotal / m_cycleCounter); }
+        // moving average of the update time in microseconds
+        uint32 GetUpdateCost() const { return m_updateCost; }
+
+        // partitioned update statistics
+        uint32 GetPartitionedUpdateCount() const { return m_partitionedCycles; }
+        float GetPartitionCountAvg() const { return m_partitionedCycles ? float(m_partitionCountTotal) / m_partitionedCycles : 0.0f; }
+        float GetPartitionSpeedup() const { return m_partitionWallTime ? float(m_partitionWorkTime) / m_partitionWallTime : 0.0f; }
 
         uint32 GetCurrentMSTime() const;
         TimePoint GetCurrentClockTime() const;
@@ -395,7 +441,18 @@ class Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        void SendObjectUpdatesParallel(MapUpdater& updater, std::vector<Object*> const& objects);
+        // objects are only added while their m_objectUpdated flag is not set, so each one is listed once
+        std::vector<Object*> i_objectsToClientUpdate;
+
+        void MarkNearbyCellsOf(WorldObject* obj, std::vector<uint32>& cells);
+        void BuildPartitions(std::vector<uint32> const& cells, std::vector<MapPartition>& partitions, std::unordered_map<uint32, uint32>& cellPartition) const;
+        bool IsPartitionLocal(WorldObject* object, uint32 partitionId, std::unordered_map<uint32, uint32> const& cellPartition);
+        void UpdateActiveCellsPartitioned(MapUpdater& updater, uint32 diff);
+        void UpdateObjectsPartitioned(MapUpdater& updater, std::vector<MapPartition>& partitions, std::vector<WorldObject*> const& serialObjects, uint32 diff);
+        static void LeaveSerialSection();
+        void PreloadGridsAhead(uint32 diff);
+        void CalculatePathRequests();
 
     protected:
         MapEntry const* i_mapEntry;
@@ -419,6 +476,29 @@ class Map : public GridRefManager<NGridType>
         std::vector<std::function<void(Map*)>> m_messageVector;
         std::mutex m_messageMutex;
 
+        // serializes changes of map containers while partitions are updated concurrently
+        class PartitionMutationGuard
+        {
+            public:
+                explicit PartitionMutationGuard(Map& map) : m_guard(map.m_partitionMutationLock, std::defer_lock)
+                {
+                    if (map.m_partitionedUpdate)
+                        m_guard.lock();
+                }
+
+            private:
+                std::unique_lock<std::recursive_mutex> m_guard;
+        };
+
+        std::atomic<bool> m_partitionedUpdate;
+        std::recursive_mutex m_partitionMutationLock;
+        std::mutex m_clientUpdateLock;
+        std::vector<std::function<void(Map*)>> m_deferredMutations;
+        std::mutex m_deferredMutationLock;
+
+        std::vector<PathFinder*> m_pathRequests;
+        std::mutex m_pathRequestLock;
+
         WorldObjectSet m_onEventNotifiedObjects;
         WorldObjectSet::iterator m_onEventNotifiedIter;
 
@@ -473,6 +553,17 @@ class Map : public GridRefManager<NGridType>
         std::atomic<uint32> m_updateTimeMin;
         std::atomic<uint32> m_updateTimeMax;
         std::atomic<uint64> m_updateTimeTotal;
+        std::atomic<uint32> m_updateCost;
+
+        // Partitioned update performance logging
+        std::atomic<uint32> m_partitionedCycles;
+        std::atomic<uint64> m_partitionCountTotal;
+        std::atomic<uint64> m_partitionWorkTime;            // sum of all partition update times, in microseconds
+        std::atomic<uint64> m_partitionWallTime;            // elapsed time of the partitioned phase, in microseconds
+
+        // player positions at the last grid preload check, their movement since then is extrapolated
+        std::unordered_map<ObjectGuid, std::pair<float, float>> m_gridPreloadPositions;
+        uint32 m_gridPreloadTimer;
 };
 
 class WorldMap : public Map
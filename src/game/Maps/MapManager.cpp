@@ -57,7 +57,10 @@ void MapManager::Initialize()
 
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
-        m_updater.activate(num_threads);
+        m_updater.activate(num_threads, sWorld.getConfig(CONFIG_BOOL_MAP_UPDATE_THREAD_AFFINITY));
+
+    if (uint32 preloadThreads = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS))
+        m_gridPreloader.Activate(preloadThreads);
 }
 
 void MapManager::InitStateMachine()
@@ -195,16 +198,32 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (auto& map : i_maps)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
-    }
+        // longest processing time first, a heavy map scheduled last would make the whole tick as long as its update
+        m_updateSchedule.clear();
+        for (auto& map : i_maps)
+            m_updateSchedule.push_back(map.second);
+
+        std::stable_sort(m_updateSchedule.begin(), m_updateSchedule.end(), [](Map * a, Map * b) { return a->GetUpdateCost() > b->GetUpdateCost(); });
+
+        {
+            std::lock_guard<std::mutex> lock(m_scheduleLock);
+            m_lastUpdateSchedule.clear();
+            for (Map* map : m_updateSchedule)
+                m_lastUpdateSchedule.push_back({ map->GetId(), map->GetInstanceId(), map->GetUpdateCost(), map->GetPlayers().getSize() });
+        }
+
+        for (Map* map : m_updateSchedule)
+            m_updater.schedule_update(new MapUpdateWorker(*map, (uint32)i_timer.GetCurrent(), m_updater));
 
-    if (m_updater.activated())
         m_updater.wait();
+    }
+    else
+    {
+        for (auto& map : i_maps)
+            map.second->Update((uint32)i_timer.GetCurrent());
+    }
 
     for (Transport* m_Transport : m_Transports)
         m_Transport->Update((uint32)i_timer.GetCurrent());
@@ -254,6 +273,9 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    // grids read in the background belong to the terrains unloaded below
+    m_gridPreloader.Deactivate();
+
     for (auto& i_map : i_maps)
         i_map.second->UnloadAll(true);
 
@@ -314,6 +336,12 @@ uint32 MapManager::GetMapUpdateAvgTime(uint32 mapId, uint32 instance)
     return i_maps[MapID(mapId, instance)]->GetUpdateTimeAvg();
 }
 
+std::vector<MapScheduleEntry> MapManager::GetLastUpdateSchedule()
+{
+    std::lock_guard<std::mutex> lock(m_scheduleLock);
+    return m_lastUpdateSchedule;
+}
+
 ///// returns a new or existing Instance
 ///// in case of battlegrounds it will only return an existing map, those maps are created by bg-system
 Map* MapManager::CreateInstance(uint32 id, Player* player)
@@ -26,6 +26,7 @@
 #include "Maps/Map.h"
 #include "Grids/GridStates.h"
 #include "Maps/MapUpdater.h"
+#include "Maps/GridPreloader.h"
 
 class Transport;
 class BattleGround;
@@ -49,6 +50,15 @@ struct MapID
     uint32 nInstanceId;
 };
 
+// Map as it was scheduled in the last map update tick
+struct MapScheduleEntry
+{
+    uint32 mapId;
+    uint32 instanceId;
+    uint32 cost;                                            // expected update time in microseconds
+    uint32 players;
+};
+
 class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex> >
 {
         friend class MaNGOS::OperatorNew<MapManager>;
@@ -148,6 +158,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         uint32 GetMapUpdateMinTime(uint32 mapId, uint32 instance = 0);
         uint32 GetMapUpdateMaxTime(uint32 mapId, uint32 instance = 0);
         uint32 GetMapUpdateAvgTime(uint32 mapId, uint32 instance = 0);
+        std::vector<MapScheduleEntry> GetLastUpdateSchedule();
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -157,6 +168,10 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void DoForAllMaps(const std::function<void(Map*)>& worker);
         void DoForAllMapsWithMapId(uint32 mapId, std::function<void(Map*)> worker);
 
+        // map update thread pool, nullptr if maps are updated in the world thread
+        MapUpdater* GetMapUpdater() { return m_updater.activated() ? &m_updater : nullptr; }
+        GridPreloader* GetGridPreloader() { return m_gridPreloader.IsActive() ? &m_gridPreloader : nullptr; }
+
     private:
 
         // debugging code, should be deleted some day
@@ -184,6 +199,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         IntervalTimer i_timer;
 
         MapUpdater m_updater;
+        GridPreloader m_gridPreloader;
+
+        std::vector<Map*> m_updateSchedule;
+        std::vector<MapScheduleEntry> m_lastUpdateSchedule;
+        std::mutex m_scheduleLock;
 };
 
 template<typename Do>
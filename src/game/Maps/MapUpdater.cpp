@@ -18,34 +18,117 @@
 
 #include "MapUpdater.h"
 #include "MapWorkers.h"
+#include "Log.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    // index of the own queue for pool threads, -1 for all other threads
+    thread_local int32 tl_queueIndex = -1;
+
+    // shares of one MapUpdater::run_shares call, helpers starting after the call returned find none left
+    struct ShareGroup
+    {
+        ShareGroup(size_t count, std::function<void(size_t)> const& share) : count(count), next(0), done(0), share(share) {}
+
+        void RunShares()
+        {
+            // the caller waits for every claimed share, so share is still valid here
+            for (size_t index = next++; index < count; index = next++)
+            {
+                share(index);
+
+                std::lock_guard<std::mutex> guard(lock);
+                if (++done == count)
+                    finished.notify_all();
+            }
+        }
+
+        size_t const count;
+        std::atomic<size_t> next;
+        size_t done;
+        std::function<void(size_t)> const& share;
+        std::mutex lock;
+        std::condition_variable finished;
+    };
+
+    class ShareWorker : public Worker
+    {
+        public:
+            ShareWorker(std::shared_ptr<ShareGroup> const& group, MapUpdater& updater) : Worker(updater), m_group(group) {}
+
+            void execute() override
+            {
+                m_group->RunShares();
+                GetWorker().update_finished();
+            }
+
+        private:
+            std::shared_ptr<ShareGroup> m_group;
+    };
+}
+
+MapUpdater::MapUpdater(size_t num_threads, bool pin_threads) : _cancelationToken(false), pending_requests(0), queued_requests(0), sleeping_workers(0), next_queue(0)
+{
+    activate(num_threads, pin_threads);
+}
+
+MapUpdater::~MapUpdater()
+{
+    if (activated() && !_cancelationToken)
+        deactivate();
 }
 
-void MapUpdater::activate(size_t num_threads)
+void MapUpdater::activate(size_t num_threads, bool pin_threads)
 {
     if (activated())
         return;
 
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue));
+
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
+
+        if (pin_threads)
+            PinThread(_workerThreads.back(), i);
+    }
 }
 
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _workAvailable.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    // drop jobs that never started
+    for (auto& queue : _queues)
+    {
+        for (Worker* worker : queue->jobs)
+            delete worker;
+        queue->jobs.clear();
+    }
 }
 
 void MapUpdater::wait()
 {
+    // fast path, no locking at all if nothing is running
+    if (pending_requests == 0)
+        return;
+
     std::unique_lock<std::mutex> lock(_lock);
 
     while (pending_requests > 0)
@@ -65,36 +148,151 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    --pending_requests;
-    _condition.notify_all();
+    // only the last finished job has to wake up the waiting thread
+    if (pending_requests.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _condition.notify_all();
+    }
 }
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
     ++pending_requests;
-    _queue.Push(std::move(worker));
+
+    // jobs scheduled from a pool thread stay local, others are spread over all queues
+    size_t index = tl_queueIndex >= 0 ? size_t(tl_queueIndex) : next_queue++ % _queues.size();
+
+    ++queued_requests;
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->lock);
+        _queues[index]->jobs.push_back(worker);
+    }
+
+    if (sleeping_workers > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _workAvailable.notify_one();
+    }
 }
 
-void MapUpdater::WorkerThread()
+Worker* MapUpdater::pop_job(size_t queue_index)
 {
-    while (true)
+    if (queued_requests == 0)
+        return nullptr;
+
+    // own queue first, in scheduling order
     {
-        Worker* request = nullptr;
+        WorkerQueue& own = *_queues[queue_index];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.jobs.empty())
+        {
+            Worker* worker = own.jobs.front();
+            own.jobs.pop_front();
+            --queued_requests;
+            return worker;
+        }
+    }
 
-        _queue.WaitAndPop(request);
+    // steal the first queued job of another worker, jobs are scheduled by decreasing cost
+    // so this keeps the most expensive remaining ones running first.
+    // The first pass skips busy queues, the second one waits for their locks so a worker
+    // never spins while jobs are still queued somewhere
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 1; i < _queues.size(); ++i)
+        {
+            WorkerQueue& victim = *_queues[(queue_index + i) % _queues.size()];
+            std::unique_lock<std::mutex> lock(victim.lock, std::defer_lock);
+            if (pass == 0)
+            {
+                if (!lock.try_lock())
+                    continue;
+            }
+            else
+                lock.lock();
+
+            if (victim.jobs.empty())
+                continue;
+
+            Worker* worker = victim.jobs.front();
+            victim.jobs.pop_front();
+            --queued_requests;
+            return worker;
+        }
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::run_shares(size_t count, std::function<void(size_t)> const& share)
+{
+    if (count == 0)
+        return;
 
-        if (_cancelationToken)
+    std::shared_ptr<ShareGroup> group = std::make_shared<ShareGroup>(count, share);
+
+    // the calling thread does not wait for the helpers to start, it takes any share they did not get to yet
+    for (size_t i = 1; i < count && i <= _workerThreads.size(); ++i)
+        schedule_update(new ShareWorker(group, *this));
+
+    group->RunShares();
+
+    std::unique_lock<std::mutex> lock(group->lock);
+    while (group->done < group->count)
+        group->finished.wait(lock);
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    tl_queueIndex = int32(index);
+
+    while (!_cancelationToken)
+    {
+        if (Worker* request = pop_job(index))
         {
+            request->execute();
+
             delete request;
-            return;
+            continue;
         }
 
-        request->execute();
+        // a job is counted before it is pushed, give the scheduling thread time to finish
+        if (queued_requests > 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
 
-        delete request;
+        // nothing to run or steal, sleep until new work is scheduled
+        std::unique_lock<std::mutex> lock(_sleepLock);
+        ++sleeping_workers;
+        while (queued_requests == 0 && !_cancelationToken)
+            _workAvailable.wait(lock);
+        --sleeping_workers;
     }
-}
\ No newline at end of file
+}
+
+void MapUpdater::PinThread(std::thread& thread, size_t index)
+{
+    unsigned int cpuCount = std::thread::hardware_concurrency();
+    if (cpuCount < 2)
+        return;
+
+    // keep the first cpu free for the world thread
+    size_t cpu = 1 + index % (cpuCount - 1);
+
+#ifdef _WIN32
+    if (!SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu))
+        sLog.outError("MapUpdater: Can't set affinity of map update thread %u to processor %u", uint32(index), uint32(cpu));
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) != 0)
+        sLog.outError("MapUpdater: Can't set affinity of map update thread %u to processor %u", uint32(index), uint32(cpu));
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
@@ -20,42 +20,64 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
+#include <functional>
 
 class Worker;
 
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
-        MapUpdater(size_t num_threads);
+        MapUpdater() : _cancelationToken(false), pending_requests(0), queued_requests(0), sleeping_workers(0), next_queue(0) {}
+        MapUpdater(size_t num_threads, bool pin_threads = false);
         MapUpdater(const MapUpdater&) = delete;
-        
-        void activate(size_t num_threads);
+        ~MapUpdater();
+
+        void activate(size_t num_threads, bool pin_threads = false);
         void deactivate();
         void wait();
         void join();
         bool activated();
         void update_finished();
         void schedule_update(Worker* worker);
+        // runs count shares of one job on the pool and in the calling thread and returns when all are done,
+        // the calling thread only takes shares of this call and never runs other queued jobs meanwhile
+        void run_shares(size_t count, std::function<void(size_t)> const& share);
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        // Each worker owns a deque, it runs its own jobs in scheduling order and steals from the front
+        // of the others when it runs dry. Both ends are FIFO on purpose: maps are scheduled by decreasing
+        // cost, popping the own queue LIFO would leave the most expensive map of each queue for last.
+        struct WorkerQueue
+        {
+            std::mutex lock;
+            std::deque<Worker*> jobs;
+        };
 
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
+        std::atomic<size_t> pending_requests;               // scheduled and not yet finished
+        std::atomic<size_t> queued_requests;                // scheduled and not yet started
+        std::atomic<size_t> sleeping_workers;
+        std::atomic<size_t> next_queue;
+
         std::mutex _lock;
-        std::condition_variable _condition;
-        size_t pending_requests;
+        std::condition_variable _condition;                 // signaled when pending_requests drops to 0
+        std::mutex _sleepLock;
+        std::condition_variable _workAvailable;
 
-        void WorkerThread();
+        Worker* pop_job(size_t queue_index);
+        void WorkerThread(size_t index);
+        static void PinThread(std::thread& thread, size_t index);
 };
 
-#endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
+#endif //_MAP_UPDATER_H_INCLUDED
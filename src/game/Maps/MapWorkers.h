@@ -23,13 +23,17 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
+#include <chrono>
+
 class Worker
 {
     public:
         Worker(MapUpdater& updater) : m_updater(updater) {}
+        virtual ~Worker() {}
         virtual void execute() {};
 
     protected:
@@ -107,4 +111,18 @@ class ObjectUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+// Set of spatially independent cells of a map and the objects found in them
+struct MapPartition
+{
+    explicit MapPartition(uint32 id) : id(id), updateTime(0) {}
+
+    uint32 id;
+    std::vector<uint32> cells;
+    WorldObjectUnSet objects;
+    uint64 updateTime;                                      // in microseconds
+};
+
+// update data of one player, in parts built by different shares, see ObjectUpdate.Parallel
+typedef std::pair<Player*, std::vector<UpdateData*>> ObjectUpdateReceiver;
+
 #endif //_MAP_WORKERS_H_INCLUDED
\ No newline at end of file
@@ -21,6 +21,10 @@
 #include "Entities/Creature.h"
 #include "MotionGenerators/MoveMap.h"
 #include "MoveMapSharedDefines.h"
+#include "MappedFile.h"
+#include "Timer.h"
+
+#include <atomic>
 
 namespace MMAP
 {
@@ -31,6 +35,16 @@ namespace MMAP
     // stores list of mapids which do not use pathfinding
     std::set<uint32>* g_mmapDisabledIds = nullptr;
 
+    namespace
+    {
+        // changed whenever a navmesh and its thread queries are freed, invalidates the per thread query caches
+        std::atomic<uint32> g_threadQueryEpoch(0);
+
+        // queries of the calling thread by map id, avoids the lookup under MMapData::threadQueryLock
+        thread_local std::unordered_map<uint32, dtNavMeshQuery const*> tl_threadQueries;
+        thread_local uint32 tl_threadQueryEpoch = 0;
+    }
+
     MMapManager* MMapFactory::createOrGetMMapManager()
     {
         if (g_MMapManager == nullptr)
@@ -118,9 +132,13 @@ namespace MMAP
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        ++g_threadQueryEpoch;
         for (auto& loadedMMap : loadedMMaps)
             delete loadedMMap.second;
 
+        for (auto& cachedTile : cachedTiles)
+            cachedTile.second.Free();
+
         // by now we should not have maps loaded
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
     }
@@ -212,28 +230,87 @@ namespace MMAP
             return false;
         }
 
-        // load this tile :: mmaps/MMMXXYY.mmtile
-        uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile") + 1;
-        char* fileName = new char[pathLen];
-        snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
+        // the tile may have been read ahead by the grid preloader or kept since its last unload
+        MMapTileData tile;
+        if (!takeCachedTile(mapId, x, y, tile) && !readTile(mapId, x, y, tile))
+            return false;
 
-        FILE* file = fopen(fileName, "rb");
-        if (!file)
+        dtMeshHeader* header = (dtMeshHeader*)tile.data;
+        dtTileRef tileRef = 0;
+
+        // the data stays ours, removeTile hands it back for the tile cache
+        dtStatus dtResult = mmap->navMesh->addTile(tile.data, tile.size, 0, 0, &tileRef);
+        if (dtStatusFailed(dtResult))
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
-            delete[] fileName;
+            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
+            tile.Free();
             return false;
         }
-        delete[] fileName;
 
-        // read header
+        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmap->mmapTileData[packedGridPos] = tile;
+        mmap->pathCache.clear();
+        ++loadedTiles;
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        return true;
+    }
+
+    void MMapTileData::Free()
+    {
+        if (file)
+            delete file;
+        else
+            dtFree(data);
+
+        data = nullptr;
+        size = 0;
+        file = nullptr;
+    }
+
+    bool MMapManager::readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile) const
+    {
+        // load this tile :: mmaps/MMMXXYY.mmtile
+        char tileName[32];
+        snprintf(tileName, sizeof(tileName), "mmaps/%03u%02i%02i.mmtile", mapId, x, y);
+        std::string fileName = sWorld.GetDataPath() + tileName;
+
         MmapTileHeader fileHeader;
-        fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
+        MappedFile* mapping = nullptr;
+        FILE* file = nullptr;
+
+        // detour writes the links of a tile into its data, so the mapping is copy-on-write;
+        // the links are spread over the poly data, so most pages of a loaded tile become private copies
+        if (sWorld.getConfig(CONFIG_BOOL_MMAP_MEMORY_MAPPED))
+        {
+            mapping = new MappedFile();
+            if (mapping->Open(fileName, true) && mapping->GetSize() >= sizeof(MmapTileHeader))
+                memcpy(&fileHeader, mapping->GetData(), sizeof(MmapTileHeader));
+            else
+            {
+                delete mapping;
+                mapping = nullptr;
+            }
+        }
+
+        if (!mapping)
+        {
+            file = fopen(fileName.c_str(), "rb");
+            if (!file)
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName.c_str());
+                return false;
+            }
+
+            // read header
+            fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
+        }
 
         if (fileHeader.mmapMagic != MMAP_MAGIC)
         {
             sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete mapping;
+            if (file)
+                fclose(file);
             return false;
         }
 
@@ -241,10 +318,27 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
                           mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
-            fclose(file);
+            delete mapping;
+            if (file)
+                fclose(file);
             return false;
         }
 
+        if (mapping)
+        {
+            if (mapping->GetSize() - sizeof(MmapTileHeader) < fileHeader.size)
+            {
+                sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+                delete mapping;
+                return false;
+            }
+
+            tile.data = mapping->GetWritableData() + sizeof(MmapTileHeader);
+            tile.size = fileHeader.size;
+            tile.file = mapping;
+            return true;
+        }
+
         unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
         MANGOS_ASSERT(data);
 
@@ -253,29 +347,96 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
+            dtFree(data);
             return false;
         }
 
         fclose(file);
 
-        dtMeshHeader* header = (dtMeshHeader*)data;
-        dtTileRef tileRef = 0;
+        tile.data = data;
+        tile.size = fileHeader.size;
+        tile.file = nullptr;
+        return true;
+    }
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
-        if (dtStatusFailed(dtResult))
+    void MMapManager::preloadTile(uint32 mapId, int32 x, int32 y)
+    {
+        uint64 key = cacheKey(mapId, x, y);
         {
-            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
-            return false;
+            std::lock_guard<std::mutex> guard(cacheLock);
+            if (cachedTileIndex.find(key) != cachedTileIndex.end())
+                return;
         }
 
-        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-        ++loadedTiles;
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        MMapTileData tile;
+        if (!readTile(mapId, x, y, tile))
+            return;
+
+        cacheTile(mapId, x, y, tile);
+    }
+
+    uint32 MMapManager::getCachedTilesCount()
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+        return cachedTileIndex.size();
+    }
+
+    bool MMapManager::takeCachedTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile)
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+
+        MMapTileCacheIndex::iterator itr = cachedTileIndex.find(cacheKey(mapId, x, y));
+        if (itr == cachedTileIndex.end())
+            return false;
+
+        tile = itr->second->second;
+        cachedTiles.erase(itr->second);
+        cachedTileIndex.erase(itr);
         return true;
     }
 
+    void MMapManager::cacheTile(uint32 mapId, int32 x, int32 y, MMapTileData const& tile)
+    {
+        uint32 cacheSize = sWorld.getConfig(CONFIG_UINT32_MMAP_TILE_CACHE_SIZE);
+        uint64 key = cacheKey(mapId, x, y);
+
+        std::lock_guard<std::mutex> guard(cacheLock);
+
+        if (!cacheSize || cachedTileIndex.find(key) != cachedTileIndex.end())
+        {
+            MMapTileData unused = tile;
+            unused.Free();
+            return;
+        }
+
+        // drop the least recently cached tiles
+        while (cachedTileIndex.size() >= cacheSize)
+        {
+            cachedTiles.front().second.Free();
+            cachedTileIndex.erase(cachedTiles.front().first);
+            cachedTiles.pop_front();
+        }
+
+        cachedTileIndex[key] = cachedTiles.insert(cachedTiles.end(), std::make_pair(key, tile));
+    }
+
+    void MMapManager::discardCachedTiles(uint32 mapId)
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+
+        for (MMapTileCacheList::iterator itr = cachedTiles.begin(); itr != cachedTiles.end();)
+        {
+            if (itr->first >> 32 == mapId)
+            {
+                itr->second.Free();
+                cachedTileIndex.erase(itr->first);
+                itr = cachedTiles.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
@@ -300,6 +461,7 @@ namespace MMAP
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
         // unload, and mark as non loaded
+        // the data is kept in the tile cache, the grid may be loaded again soon
         dtStatus dtResult = mmap->navMesh->removeTile(tileRef, nullptr, nullptr);
         if (dtStatusFailed(dtResult))
         {
@@ -311,7 +473,10 @@ namespace MMAP
         }
         else
         {
+            cacheTile(mapId, x, y, mmap->mmapTileData[packedGridPos]);
+            mmap->mmapTileData.erase(packedGridPos);
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            mmap->pathCache.clear();
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -322,6 +487,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        discardCachedTiles(mapId);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
@@ -345,6 +512,7 @@ namespace MMAP
             }
         }
 
+        ++g_threadQueryEpoch;
         delete mmap;
         loadedMMaps.erase(mapId);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
@@ -386,6 +554,60 @@ namespace MMAP
         return loadedMMaps[mapId]->navMesh;
     }
 
+    MMapPathCache* MMapManager::GetPathCache(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        return &itr->second->pathCache;
+    }
+
+    dtNavMeshQuery const* MMapManager::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        uint32 epoch = g_threadQueryEpoch.load();
+        if (tl_threadQueryEpoch != epoch)
+        {
+            tl_threadQueries.clear();
+            tl_threadQueryEpoch = epoch;
+        }
+        else
+        {
+            auto cached = tl_threadQueries.find(mapId);
+            if (cached != tl_threadQueries.end())
+                return cached->second;
+        }
+
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        std::lock_guard<std::mutex> guard(mmap->threadQueryLock);
+
+        NavMeshThreadQuerySet::const_iterator query = mmap->threadQueries.find(std::this_thread::get_id());
+        if (query != mmap->threadQueries.end())
+        {
+            tl_threadQueries[mapId] = query->second;
+            return query->second;
+        }
+
+        dtNavMeshQuery* threadQuery = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(threadQuery);
+        dtStatus dtResult = threadQuery->init(mmap->navMesh, 1024);
+        if (dtStatusFailed(dtResult))
+        {
+            dtFreeNavMeshQuery(threadQuery);
+            sLog.outError("MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetThreadNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+        mmap->threadQueries.insert(NavMeshThreadQuerySet::value_type(std::this_thread::get_id(), threadQuery));
+        tl_threadQueries[mapId] = threadQuery;
+        return threadQuery;
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
@@ -411,4 +633,84 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    ////////////////// MMapPathCache //////////////////
+
+    // corridors are found between positions inside the polys, a reused one gets less optimal the older it is
+    static const uint32 MMAP_PATH_CACHE_LIFETIME = 1000;
+
+    MMapPathCache::PathKey MMapPathCache::makeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter)
+    {
+        PathKey key;
+        key.startPoly = startPoly;
+        key.endPoly = endPoly;
+        key.includeFlags = filter.getIncludeFlags();
+        key.excludeFlags = filter.getExcludeFlags();
+        return key;
+    }
+
+    bool MMapPathCache::find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtNavMesh const* navMesh,
+                             dtPolyRef* path, uint32& length, uint32 maxLength)
+    {
+        if (!sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE))
+            return false;
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        auto itr = paths.find(makeKey(startPoly, endPoly, filter));
+        if (itr == paths.end())
+            return false;
+
+        CachedPath const& cached = itr->second;
+        if (WorldTimer::getMSTimeDiff(cached.time, WorldTimer::getMSTime()) > MMAP_PATH_CACHE_LIFETIME || cached.polys.size() > maxLength)
+        {
+            paths.erase(itr);
+            return false;
+        }
+
+        // make sure no tile of the corridor was exchanged since
+        for (dtPolyRef poly : cached.polys)
+            if (!navMesh->isValidPolyRef(poly))
+                return false;
+
+        std::copy(cached.polys.begin(), cached.polys.end(), path);
+        length = cached.polys.size();
+        return true;
+    }
+
+    void MMapPathCache::add(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 length)
+    {
+        uint32 cacheSize = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE);
+        if (!cacheSize || !length)
+            return;
+
+        uint32 now = WorldTimer::getMSTime();
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        // drop the expired corridors, or all of them if they are still recent
+        if (paths.size() >= cacheSize)
+        {
+            for (auto itr = paths.begin(); itr != paths.end();)
+            {
+                if (WorldTimer::getMSTimeDiff(itr->second.time, now) > MMAP_PATH_CACHE_LIFETIME)
+                    itr = paths.erase(itr);
+                else
+                    ++itr;
+            }
+
+            if (paths.size() >= cacheSize)
+                paths.clear();
+        }
+
+        CachedPath& cached = paths[makeKey(startPoly, endPoly, filter)];
+        cached.polys.assign(path, path + length);
+        cached.time = now;
+    }
+
+    void MMapPathCache::clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        paths.clear();
+    }
 }
@@ -24,6 +24,12 @@
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
 
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MappedFile;
 class Unit;
 
 //  memory management
@@ -40,8 +46,67 @@ inline void dtCustomFree(void* ptr)
 //  move map related classes
 namespace MMAP
 {
+    // navmesh data of a tile, tiles are added without DT_TILE_FREE_DATA so the data outlives them
+    struct MMapTileData
+    {
+        MMapTileData() : data(nullptr), size(0), file(nullptr) {}
+
+        void Free();
+
+        unsigned char* data;
+        uint32 size;
+        MappedFile* file;                   // set if data points into a copy-on-write mapping of the tile file
+    };
+
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
+    typedef std::unordered_map<uint32, MMapTileData> MMapTileDataSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshThreadQuerySet;
+
+    // poly corridors recently found on a map, units chasing the same target mostly search the same corridor
+    class MMapPathCache
+    {
+        public:
+            bool find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtNavMesh const* navMesh,
+                      dtPolyRef* path, uint32& length, uint32 maxLength);
+            void add(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 length);
+            void clear();
+
+        private:
+            struct PathKey
+            {
+                dtPolyRef startPoly;
+                dtPolyRef endPoly;
+                uint16 includeFlags;
+                uint16 excludeFlags;
+
+                bool operator==(PathKey const& other) const
+                {
+                    return startPoly == other.startPoly && endPoly == other.endPoly &&
+                           includeFlags == other.includeFlags && excludeFlags == other.excludeFlags;
+                }
+            };
+
+            struct PathKeyHash
+            {
+                size_t operator()(PathKey const& key) const
+                {
+                    return std::hash<dtPolyRef>()(key.startPoly) ^ (std::hash<dtPolyRef>()(key.endPoly) << 1) ^
+                           ((key.includeFlags << 16) | key.excludeFlags);
+                }
+            };
+
+            struct CachedPath
+            {
+                std::vector<dtPolyRef> polys;
+                uint32 time;                    // when the corridor was found
+            };
+
+            static PathKey makeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter);
+
+            std::unordered_map<PathKey, CachedPath, PathKeyHash> paths;
+            std::mutex lock;
+    };
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -52,19 +117,33 @@ namespace MMAP
             for (auto& navMeshQuerie : navMeshQueries)
                 dtFreeNavMeshQuery(navMeshQuerie.second);
 
+            for (auto& threadQuery : threadQueries)
+                dtFreeNavMeshQuery(threadQuery.second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
+
+            for (auto& tile : mmapTileData)
+                tile.second.Free();
         }
 
         dtNavMesh* navMesh;
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshThreadQuerySet threadQueries;    // thread to query, for path calculations on any thread
+        std::mutex threadQueryLock;
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileDataSet mmapTileData;       // maps [map grid coords] to the data of the loaded tile
+        MMapPathCache pathCache;            // shared by all instances, cleared when tiles change
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    // tiles read ahead by the grid preloader and recently unloaded tiles, least recently cached first
+    typedef std::list<std::pair<uint64, MMapTileData>> MMapTileCacheList;
+    typedef std::unordered_map<uint64, MMapTileCacheList::iterator> MMapTileCacheIndex;  // maps [map id, grid coords] to cached tile
+
     // singelton class
     // holds all all access to mmap loading unloading and meshes
     class MMapManager
@@ -79,18 +158,34 @@ namespace MMAP
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
             bool IsMMapIsLoaded(uint32 mapId, uint32 x, uint32 y) const;
 
+            // reads a tile file for a later loadMap, may be called from any thread
+            void preloadTile(uint32 mapId, int32 x, int32 y);
+            uint32 getCachedTilesCount();
+
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // query owned by the calling thread, threads may calculate paths on the same map concurrently
+            dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            MMapPathCache* GetPathCache(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
+            bool readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile) const;
+            uint64 cacheKey(uint32 mapId, int32 x, int32 y) const { return (uint64(mapId) << 32) | packTileID(x, y); }
+            bool takeCachedTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile);
+            void cacheTile(uint32 mapId, int32 x, int32 y, MMapTileData const& tile);
+            void discardCachedTiles(uint32 mapId);
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+
+            MMapTileCacheList cachedTiles;
+            MMapTileCacheIndex cachedTileIndex;
+            std::mutex cacheLock;
     };
 
     // static class
@@ -19,6 +19,7 @@
 #include "MotionGenerators/MoveMap.h"
 #include "Maps/GridMap.h"
 #include "Entities/Creature.h"
+#include "Maps/Map.h"
 #include "MotionGenerators/PathFinder.h"
 #include "Log.h"
 #include "World/World.h"
@@ -28,9 +29,10 @@
 
 ////////////////// PathFinder //////////////////
 PathFinder::PathFinder(Unit const* owner) :
-    m_polyLength(0), m_type(PATHFIND_BLANK),
+    m_polyLength(0), m_corridorEndPoly(INVALID_POLYREF), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
-    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr)
+    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr),
+    m_pendingMap(nullptr), m_pendingForceDest(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -39,7 +41,7 @@ PathFinder::PathFinder(Unit const* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         m_navMesh = mmap->GetNavMesh(mapId);
-        m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
+        m_pathCache = mmap->GetPathCache(mapId);
     }
 
     createFilter();
@@ -48,6 +50,47 @@ PathFinder::PathFinder(Unit const* owner) :
 PathFinder::~PathFinder()
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+
+    cancelAsync();
+}
+
+void PathFinder::calculateAsync(float destX, float destY, float destZ, bool forceDest/* = false*/)
+{
+    cancelAsync();
+
+    float x, y, z;
+    m_sourceUnit->GetPosition(x, y, z);
+
+    m_pendingStart = Vector3(x, y, z);
+    m_pendingDest = Vector3(destX, destY, destZ);
+    m_pendingForceDest = forceDest;
+    m_pendingMap = m_sourceUnit->GetMap();
+    m_pendingMap->AddPathRequest(this);
+}
+
+void PathFinder::cancelAsync()
+{
+    if (!m_pendingMap)
+        return;
+
+    m_pendingMap->RemovePathRequest(this);
+    m_pendingMap = nullptr;
+}
+
+void PathFinder::calculatePending()
+{
+    Map* map = m_pendingMap;
+    m_pendingMap = nullptr;
+
+    // the owner left the map since the request
+    if (!m_sourceUnit->IsInWorld() || m_sourceUnit->GetMap() != map)
+    {
+        clear();
+        m_type = PATHFIND_NOPATH;
+        return;
+    }
+
+    calculate(m_pendingStart, m_pendingDest, m_pendingForceDest);
 }
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest/* = false*/)
@@ -74,6 +117,13 @@ bool PathFinder::calculate(const Vector3& start, const Vector3& dest, bool force
 
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
 
+    // a queued calculation would overwrite this result
+    cancelAsync();
+
+    // queries are not thread safe, each thread calculating paths has its own
+    if (m_navMesh)
+        m_navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->GetThreadNavMeshQuery(m_sourceUnit->GetMapId());
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
@@ -243,6 +293,8 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         m_pathPolyRefs[0] = startPoly;
         m_polyLength = 1;
+        m_corridorEndPoly = endPoly;
+        dtVcopy(m_corridorEndPoint, endPoint);
 
         m_type = farFromPoly ? PATHFIND_INCOMPLETE : PATHFIND_NORMAL;
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: path type %d\n", m_type);
@@ -306,60 +358,68 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // so we have atleast part of poly-path ready
 
         m_polyLength -= pathStartIndex;
+        memmove(m_pathPolyRefs, m_pathPolyRefs + pathStartIndex, m_polyLength * sizeof(dtPolyRef));
 
-        // try to adjust the suffix of the path instead of recalculating entire length
-        // at given interval the target cannot get too far from its last location
-        // thus we have less poly to cover
-        // sub-path of optimal path is optimal
+        // the target moved only a few yards, move the end of the corridor after it
+        if (moveCorridorEnd(endPoint, endPoly))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u moved corridor end\n", m_polyLength);
+        }
+        else
+        {
+            // try to adjust the suffix of the path instead of recalculating entire length
+            // at given interval the target cannot get too far from its last location
+            // thus we have less poly to cover
+            // sub-path of optimal path is optimal
 
-        // take ~80% of the original length
-        // TODO : play with the values here
-        uint32 prefixPolyLength = uint32(m_polyLength * 0.8f + 0.5f);
-        memmove(m_pathPolyRefs, m_pathPolyRefs + pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
+            // take ~80% of the original length
+            // TODO : play with the values here
+            uint32 prefixPolyLength = uint32(m_polyLength * 0.8f + 0.5f);
 
-        dtPolyRef suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+            dtPolyRef suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
 
-        // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
-        float suffixEndPoint[VERTEX_SIZE];
-        if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
-        {
-            // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
-            // try to recover by using prev polyref
-            --prefixPolyLength;
-            suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+            // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
+            float suffixEndPoint[VERTEX_SIZE];
             if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
             {
-                // suffixStartPoly is still invalid, error state
-                BuildShortcut();
-                m_type = PATHFIND_NOPATH;
-                return;
+                // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
+                // try to recover by using prev polyref
+                --prefixPolyLength;
+                suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+                if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
+                {
+                    // suffixStartPoly is still invalid, error state
+                    BuildShortcut();
+                    m_type = PATHFIND_NOPATH;
+                    return;
+                }
             }
-        }
-
-        // generate suffix
-        uint32 suffixPolyLength = 0;
-        dtResult = m_navMeshQuery->findPath(
-                       suffixStartPoly,    // start polygon
-                       endPoly,            // end polygon
-                       suffixEndPoint,     // start position
-                       endPoint,           // end position
-                       &m_filter,            // polygon search filter
-                       m_pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                       (int*)&suffixPolyLength,
-                       MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
 
-        if (!suffixPolyLength || dtStatusFailed(dtResult))
-        {
-            // this is probably an error state, but we'll leave it
-            // and hopefully recover on the next Update
-            // we still need to copy our preffix
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-        }
+            // generate suffix
+            uint32 suffixPolyLength = 0;
+            dtResult = m_navMeshQuery->findPath(
+                           suffixStartPoly,    // start polygon
+                           endPoly,            // end polygon
+                           suffixEndPoint,     // start position
+                           endPoint,           // end position
+                           &m_filter,            // polygon search filter
+                           m_pathPolyRefs + prefixPolyLength - 1,    // [out] path
+                           (int*)&suffixPolyLength,
+                           MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
+
+            if (!suffixPolyLength || dtStatusFailed(dtResult))
+            {
+                // this is probably an error state, but we'll leave it
+                // and hopefully recover on the next Update
+                // we still need to copy our preffix
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+            }
 
-        DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", m_polyLength, prefixPolyLength, suffixPolyLength);
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", m_polyLength, prefixPolyLength, suffixPolyLength);
 
-        // new path = prefix + suffix - overlap
-        m_polyLength = prefixPolyLength + suffixPolyLength - 1;
+            // new path = prefix + suffix - overlap
+            m_polyLength = prefixPolyLength + suffixPolyLength - 1;
+        }
     }
     else
     {
@@ -372,26 +432,40 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // another unit may just have searched the same corridor
+        if (m_pathCache && m_pathCache->find(startPoly, endPoly, m_filter, m_navMesh, m_pathPolyRefs, m_polyLength, MAX_PATH_LENGTH))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: cached corridor m_polyLength=%u\n", m_polyLength);
+        }
+        else
+        {
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            if (m_pathCache)
+                m_pathCache->add(startPoly, endPoly, m_filter, m_pathPolyRefs, m_polyLength);
         }
     }
 
+    m_corridorEndPoly = endPoly;
+    dtVcopy(m_corridorEndPoint, endPoint);
+
     // by now we know what type of path we can get
     if (m_pathPolyRefs[m_polyLength - 1] == endPoly && !(m_type & PATHFIND_INCOMPLETE))
         m_type = PATHFIND_NORMAL;
@@ -558,6 +632,26 @@ void PathFinder::NormalizePath()
     if (!sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z))
         return;
 
+    // walking units are put on the ground, same as Unit::UpdateAllowedPositionZ, with all points sampled at once
+    if (!m_sourceUnit->CanFly() && !m_sourceUnit->CanSwim())
+    {
+        uint32 count = m_pathPoints.size();
+        std::vector<float> x(count), y(count), z(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            x[i] = m_pathPoints[i].x;
+            y[i] = m_pathPoints[i].y;
+            z[i] = m_pathPoints[i].z;
+        }
+
+        m_sourceUnit->GetMap()->GetHeights(m_sourceUnit->GetPhaseMask(), x.data(), y.data(), z.data(), count);
+
+        for (uint32 i = 0; i < count; ++i)
+            if (z[i] > INVALID_HEIGHT)
+                m_pathPoints[i].z = z[i];
+        return;
+    }
+
     for (auto& m_pathPoint : m_pathPoints)
         m_sourceUnit->UpdateAllowedPositionZ(m_pathPoint.x, m_pathPoint.y, m_pathPoint.z);
 }
@@ -658,6 +752,29 @@ bool PathFinder::HaveTile(const Vector3& p) const
     return (m_navMesh->getTileAt(tx, ty, 0) != nullptr); // Don't use layer so always set to 0
 }
 
+bool PathFinder::moveCorridorEnd(const float* endPoint, dtPolyRef endPoly)
+{
+    // the previous path did not reach its end polygon
+    if (!m_polyLength || m_pathPolyRefs[m_polyLength - 1] != m_corridorEndPoly)
+        return false;
+
+    if (dtVdistSqr(m_corridorEndPoint, endPoint) > CORRIDOR_MOVE_TARGET_DIST * CORRIDOR_MOVE_TARGET_DIST)
+        return false;
+
+    float resultPoint[VERTEX_SIZE];
+    dtPolyRef visited[CORRIDOR_MAX_VISITED];
+    int visitedCount = 0;
+    dtStatus dtResult = m_navMeshQuery->moveAlongSurface(m_corridorEndPoly, m_corridorEndPoint, endPoint, &m_filter,
+                        resultPoint, visited, &visitedCount, CORRIDOR_MAX_VISITED);
+
+    // the target is not reachable by moving straight over the surface, e.g. behind a wall
+    if (dtStatusFailed(dtResult) || !visitedCount || visited[visitedCount - 1] != endPoly)
+        return false;
+
+    m_polyLength = fixupCorridorEnd(m_pathPolyRefs, m_polyLength, MAX_PATH_LENGTH, visited, visitedCount);
+    return m_pathPolyRefs[m_polyLength - 1] == endPoly;
+}
+
 uint32 PathFinder::fixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
 {
     int32 furthestPath = -1;
@@ -703,6 +820,42 @@ uint32 PathFinder::fixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath,
     return req + size;
 }
 
+uint32 PathFinder::fixupCorridorEnd(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
+{
+    int32 furthestPath = -1;
+    int32 furthestVisited = -1;
+
+    // Find first common polygon from the start of the path.
+    for (uint32 i = 0; i < npath; ++i)
+    {
+        bool found = false;
+        for (int32 j = nvisited - 1; j >= 0; --j)
+        {
+            if (path[i] == visited[j])
+            {
+                furthestPath = i;
+                furthestVisited = j;
+                found = true;
+            }
+        }
+        if (found)
+            break;
+    }
+
+    // If no intersection found just return current path.
+    if (furthestPath == -1 || furthestVisited == -1)
+        return npath;
+
+    // Concatenate paths.
+    uint32 ppos = furthestPath + 1;
+    uint32 vpos = furthestVisited + 1;
+    uint32 count = std::min(nvisited - vpos, maxPath - ppos);
+    if (count)
+        memcpy(path + ppos, visited + vpos, count * sizeof(dtPolyRef));
+
+    return ppos + count;
+}
+
 bool PathFinder::getSteerTarget(const float* startPos, const float* endPos,
                                 float minTargetDist, const dtPolyRef* path, uint32 pathSize,
                                 float* steerPos, unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const
@@ -29,8 +29,14 @@
 using Movement::Vector3;
 using Movement::PointsArray;
 
+class Map;
 class Unit;
 
+namespace MMAP
+{
+    class MMapPathCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -40,6 +46,10 @@ class Unit;
 #define SMOOTH_PATH_STEP_SIZE   4.0f
 #define SMOOTH_PATH_SLOP        0.3f
 
+// the end of the corridor follows a target moving less than this over the mesh surface
+#define CORRIDOR_MOVE_TARGET_DIST   10.0f
+#define CORRIDOR_MAX_VISITED        16
+
 // How many points can be cutted
 // May occupt visual bugs when lenght > 20y
 #define SKIP_POINT_LIMIT        6
@@ -71,6 +81,13 @@ class PathFinder
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
         bool calculate(const Vector3& start, const Vector3& dest, bool forceDest = false);
 
+        // queue the calculation to the map of the owner, which calculates all queued paths in parallel
+        // after its object updates; the result is available when isPending() returns false, at the latest next tick
+        void calculateAsync(float destX, float destY, float destZ, bool forceDest = false);
+        bool isPending() const { return m_pendingMap != nullptr; }
+        void cancelAsync();
+        void calculatePending();                   // for Map, calculates the queued path
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); };
@@ -87,6 +104,8 @@ class PathFinder
 
         dtPolyRef      m_pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32         m_polyLength;                      // number of polygons in the path
+        dtPolyRef      m_corridorEndPoly;                 // end polygon the poly path was built for
+        float          m_corridorEndPoint[VERTEX_SIZE];   // end point the poly path was built for
 
         PointsArray    m_pathPoints;       // our actual (x,y,z) path to the target
         PathType       m_type;             // tells what kind of path this is
@@ -101,7 +120,13 @@ class PathFinder
 
         const Unit* const       m_sourceUnit;       // the unit that is moving
         const dtNavMesh*        m_navMesh;          // the nav mesh
-        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query of the calculating thread
+        MMAP::MMapPathCache*    m_pathCache;        // corridors recently found on the map
+
+        Map*           m_pendingMap;       // map the queued calculation was added to
+        Vector3        m_pendingStart;
+        Vector3        m_pendingDest;
+        bool           m_pendingForceDest;
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -127,6 +152,7 @@ class PathFinder
         void BuildPolyPath(const Vector3& startPos, const Vector3& endPos);
         void BuildPointPath(const float* startPoint, const float* endPoint);
         void BuildShortcut();
+        bool moveCorridorEnd(const float* endPoint, dtPolyRef endPoly);
 
         NavTerrain getNavTerrain(float x, float y, float z) const;
         void createFilter();
@@ -135,6 +161,8 @@ class PathFinder
         // smooth path aux functions
         uint32 fixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath,
                              const dtPolyRef* visited, uint32 nvisited);
+        uint32 fixupCorridorEnd(dtPolyRef* path, uint32 npath, uint32 maxPath,
+                                const dtPolyRef* visited, uint32 nvisited);
         bool getSteerTarget(const float* startPos, const float* endPos, float minTargetDist,
                             const dtPolyRef* path, uint32 pathSize, float* steerPos,
                             unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const;
@@ -77,7 +77,8 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
 
     HandleTargetedMovement(owner, time_diff);
 
-    if (owner.movespline->Finalized() && !i_targetReached) 
+    // the spline of an asynchronous path is not launched yet
+    if (owner.movespline->Finalized() && !i_targetReached && !i_waitingForPath)
         HandleFinalizedMovement(owner);
 
     return true;
@@ -124,6 +125,10 @@ void ChaseMovementGenerator::Initialize(Unit& owner)
 
 void ChaseMovementGenerator::Finalize(Unit& owner)
 {
+    if (i_path)
+        i_path->cancelAsync();
+    i_waitingForPath = false;
+
     owner.clearUnitState(UNIT_STAT_CHASE | UNIT_STAT_CHASE_MOVE);
     if (m_currentMode == CHASE_MODE_DISTANCING) // cleanup in case fanning was removed
         owner.AI()->DistancingEnded();
@@ -131,6 +136,10 @@ void ChaseMovementGenerator::Finalize(Unit& owner)
 
 void ChaseMovementGenerator::Interrupt(Unit& owner)
 {
+    if (i_path)
+        i_path->cancelAsync();
+    i_waitingForPath = false;
+
     owner.InterruptMoving();
     owner.clearUnitState(UNIT_STAT_CHASE_MOVE);
     if (m_currentMode == CHASE_MODE_DISTANCING)
@@ -188,6 +197,24 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
         }
         else m_closenessAndFanningTimer -= time_diff;
     }
+
+    if (this->i_waitingForPath)
+    {
+        if (this->i_path->isPending())
+            return;
+
+        this->i_waitingForPath = false;
+        if (LaunchPath(owner, m_pendingWalk, m_pendingCutPath, m_pendingTarget))
+        {
+            this->i_targetReached = false;
+            this->i_speedChanged = false;
+            m_closenessAndFanningTimer = 0;
+        }
+        else
+            m_reachable = false;
+        return;
+    }
+
     if (!this->i_recheckDistance.Passed())
         return;
 
@@ -214,8 +241,12 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
                 z = end.z;
             }
 
-            if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true))
+            if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true, sWorld.getConfig(CONFIG_BOOL_PATH_FIND_ASYNC)))
             {
+                // the state changes once the spline is launched
+                if (this->i_waitingForPath)
+                    return;
+
                 this->i_targetReached = false;
                 this->i_speedChanged = false;
                 /* m_prevTargetPos is updated on making new spline (normal and distancing) and also on reaching target
@@ -407,13 +438,30 @@ void ChaseMovementGenerator::FanOut(Unit& owner)
     }
 }
 
-bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target)
+bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target, bool async)
 {
     if (!this->i_path)
         this->i_path = new PathFinder(&owner);
 
+    if (async)
+    {
+        // the map calculates the path after its object updates, it is launched from the next update
+        this->i_path->calculateAsync(x, y, z, false);
+        this->i_waitingForPath = true;
+        m_pendingWalk = walk;
+        m_pendingCutPath = cutPath;
+        m_pendingTarget = target;
+        return true;
+    }
+
+    this->i_waitingForPath = false;
     this->i_path->calculate(x, y, z, false);
 
+    return LaunchPath(owner, walk, cutPath, target);
+}
+
+bool ChaseMovementGenerator::LaunchPath(Unit& owner, bool walk, bool cutPath, bool target)
+{
     if (this->i_path->getPathType() & PATHFIND_NOPATH)
         return false;
 
@@ -44,8 +44,8 @@ class TargetedMovementGeneratorMedium
             TargetedMovementGeneratorBase(target),
             i_recheckDistance(0),
             i_offset(offset), i_angle(angle),
-            i_speedChanged(false), i_targetReached(false),
-            i_path(nullptr), i_faceTarget(true)
+            i_speedChanged(false), i_targetReached(false), i_faceTarget(true), i_waitingForPath(false),
+            i_path(nullptr)
         {
         }
         ~TargetedMovementGeneratorMedium() { delete i_path; }
@@ -80,6 +80,7 @@ class TargetedMovementGeneratorMedium
         bool i_speedChanged : 1;
         bool i_targetReached : 1;
         bool i_faceTarget : 1;
+        bool i_waitingForPath : 1;                          // an asynchronous path is calculated, see PathFinder::calculateAsync
 
         PathFinder* i_path;
 };
@@ -107,7 +108,7 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
     using TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator>::i_angle;
     public:
         ChaseMovementGenerator(Unit& target, float offset, float angle, bool moveFurther = true, bool walk = false, bool combat = true)
-            : TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator >(target, offset, angle), m_moveFurther(moveFurther), m_walk(walk), m_combat(combat), m_currentMode(CHASE_MODE_NORMAL),
+            : TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator >(target, offset, angle), m_moveFurther(moveFurther), m_walk(walk), m_combat(combat), m_pendingWalk(false), m_pendingCutPath(false), m_pendingTarget(false), m_currentMode(CHASE_MODE_NORMAL),
               m_fanningEnabled(true), m_closenessAndFanningTimer(0), m_closenessExpired(false), m_reachable(true) {}
         ~ChaseMovementGenerator() {}
 
@@ -146,13 +147,17 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
         virtual bool _getLocation(Unit& owner, float& x, float& y, float& z) const;
         virtual void _setLocation(Unit& owner);
 
-        bool DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target = false);
+        bool DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target = false, bool async = false);
+        bool LaunchPath(Unit& owner, bool walk, bool cutPath, bool target);
         void CutPath(Unit& owner, PointsArray& path);
         void Backpedal(Unit& owner);
 
         bool m_moveFurther;
         bool m_walk;
         bool m_combat;
+        bool m_pendingWalk;                                 // spline options of the asynchronous path
+        bool m_pendingCutPath;
+        bool m_pendingTarget;
         bool m_reachable;
         bool m_fanningEnabled;
 
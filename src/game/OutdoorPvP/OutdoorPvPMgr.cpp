@@ -21,6 +21,7 @@
 #include "OutdoorPvP.h"
 #include "World/World.h"
 #include "Log.h"
+#include "Maps/Map.h"
 #include "OutdoorPvPEP.h"
 #include "OutdoorPvPGH.h"
 #include "OutdoorPvPHP.h"
@@ -81,6 +82,9 @@ void OutdoorPvPMgr::InitOutdoorPvP()
 
 OutdoorPvP* OutdoorPvPMgr::GetScript(uint32 zoneId)
 {
+    // scripts are shared by all objects of their zones
+    Map::EnterSerialSection();
+
     switch (zoneId)
     {
         case ZONE_ID_SILITHUS:
@@ -106,6 +110,9 @@ OutdoorPvP* OutdoorPvPMgr::GetScript(uint32 zoneId)
 
 OutdoorPvP* OutdoorPvPMgr::GetScriptOfAffectedZone(uint32 zoneId)
 {
+    // scripts are shared by all objects of their zones
+    Map::EnterSerialSection();
+
     switch (zoneId)
     {
         case ZONE_ID_TEMPLE_OF_AQ:
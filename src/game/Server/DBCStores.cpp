@@ -26,6 +26,10 @@
 #include "DBCfmt.h"
 
 #include <map>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 typedef std::map<uint16, uint32> AreaFlagByAreaID;
 typedef std::map<uint32, uint32> AreaFlagByMapID;
@@ -276,14 +280,18 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
 
 struct LocalData
 {
-    LocalData(uint32 build)
-        : main_build(build), availableDbcLocales(0xFFFFFFFF), checkedDbcLocaleBuilds(0) {}
+    LocalData(uint32 build, bool mapped_)
+        : main_build(build), mapped(mapped_), availableDbcLocales(0xFFFFFFFF), checkedDbcLocaleBuilds(0) {}
 
     uint32 main_build;
+    bool mapped;
 
     // bitmasks for index of fullLocaleNameList
     uint32 availableDbcLocales;
     uint32 checkedDbcLocaleBuilds;
+
+    // guards the locale masks, progress bar and problem list when loading in parallel
+    std::mutex lock;
 };
 
 template<class T>
@@ -293,8 +301,10 @@ inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& err
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
     std::string dbc_filename = dbc_path + filename;
-    if (storage.Load(dbc_filename.c_str()))
+    if (storage.Load(dbc_filename.c_str(), localeData.mapped))
     {
+        std::lock_guard<std::mutex> guard(localeData.lock);
+
         bar.step();
         for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
         {
@@ -328,12 +338,19 @@ inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& err
             }
 
             std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
-            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+
+            localeData.lock.unlock();
+            bool loaded = storage.LoadStringsFrom(dbc_filename_loc.c_str(), localeData.mapped);
+            localeData.lock.lock();
+
+            if (!loaded)
                 localeData.availableDbcLocales &= ~(1 << i);// mark as not available for speedup next checks
         }
     }
     else
     {
+        std::lock_guard<std::mutex> guard(localeData.lock);
+
         // sort problematic dbc to (1) non compatible and (2) nonexistent
         FILE* f = fopen(dbc_filename.c_str(), "rb");
         if (f)
@@ -348,7 +365,48 @@ inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& err
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+// Collects the DBC loads of LoadDBCStores, the files are independent and can be loaded in parallel
+class DBCLoadQueue
+{
+    public:
+        DBCLoadQueue(LocalData& localeData, BarGoLink& bar, StoreProblemList& errlist, std::string const& dbcPath)
+            : m_localeData(localeData), m_bar(bar), m_errlist(errlist), m_dbcPath(dbcPath) {}
+
+        template<class T>
+        void Add(DBCStorage<T>& storage, char const* filename)
+        {
+            m_loads.push_back([this, &storage, filename]() { LoadDBC(m_localeData, m_bar, m_errlist, storage, m_dbcPath, filename); });
+        }
+
+        void Run(uint32 threads)
+        {
+            std::atomic<size_t> next(0);
+            auto worker = [this, &next]()
+            {
+                for (size_t i = next++; i < m_loads.size(); i = next++)
+                    m_loads[i]();
+            };
+
+            // the calling thread is one of the loaders
+            std::vector<std::thread> workers;
+            for (uint32 i = 1; i < threads; ++i)
+                workers.emplace_back(worker);
+
+            worker();
+
+            for (std::thread& thread : workers)
+                thread.join();
+        }
+
+    private:
+        LocalData& m_localeData;
+        BarGoLink& m_bar;
+        StoreProblemList& m_errlist;
+        std::string const& m_dbcPath;
+        std::vector<std::function<void()>> m_loads;
+};
+
+void LoadDBCStores(const std::string& dataPath, uint32 threads, bool mapped)
 {
     std::string dbcPath = dataPath + "dbc/";
 
@@ -371,9 +429,114 @@ void LoadDBCStores(const std::string& dataPath)
 
     StoreProblemList bad_dbc_files;
 
-    LocalData availableDbcLocales(build);
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaStore,                dbcPath, "AreaTable.dbc");
+    LocalData availableDbcLocales(build, mapped);
+
+    DBCLoadQueue loads(availableDbcLocales, bar, bad_dbc_files, dbcPath);
+    loads.Add(sAreaStore,                "AreaTable.dbc");
+    loads.Add(sAchievementStore,         "Achievement.dbc");
+    loads.Add(sAchievementCriteriaStore, "Achievement_Criteria.dbc");
+    loads.Add(sAreaTriggerStore,         "AreaTrigger.dbc");
+    loads.Add(sAuctionHouseStore,        "AuctionHouse.dbc");
+    loads.Add(sBankBagSlotPricesStore,   "BankBagSlotPrices.dbc");
+    loads.Add(sBattlemasterListStore,    "BattlemasterList.dbc");
+    loads.Add(sBarberShopStyleStore,     "BarberShopStyle.dbc");
+    loads.Add(sCharStartOutfitStore,     "CharStartOutfit.dbc");
+    loads.Add(sCharTitlesStore,          "CharTitles.dbc");
+    loads.Add(sChatChannelsStore,        "ChatChannels.dbc");
+    loads.Add(sChrClassesStore,          "ChrClasses.dbc");
+    loads.Add(sChrRacesStore,            "ChrRaces.dbc");
+    loads.Add(sCinematicCameraStore,     "CinematicCamera.dbc");
+    loads.Add(sCinematicSequencesStore,  "CinematicSequences.dbc");
+    loads.Add(sCreatureDisplayInfoStore, "CreatureDisplayInfo.dbc");
+    loads.Add(sCreatureDisplayInfoExtraStore, "CreatureDisplayInfoExtra.dbc");
+    loads.Add(sCreatureModelDataStore,   "CreatureModelData.dbc");
+    loads.Add(sCreatureFamilyStore,      "CreatureFamily.dbc");
+    loads.Add(sCreatureSpellDataStore,   "CreatureSpellData.dbc");
+    loads.Add(sCreatureTypeStore,        "CreatureType.dbc");
+    loads.Add(sCurrencyTypesStore,       "CurrencyTypes.dbc");
+    loads.Add(sDestructibleModelDataStore, "DestructibleModelData.dbc");
+    loads.Add(sDurabilityCostsStore,     "DurabilityCosts.dbc");
+    loads.Add(sDurabilityQualityStore,   "DurabilityQuality.dbc");
+    loads.Add(sEmotesStore,              "Emotes.dbc");
+    loads.Add(sEmotesTextStore,          "EmotesText.dbc");
+    loads.Add(sFactionStore,             "Faction.dbc");
+    loads.Add(sFactionTemplateStore,     "FactionTemplate.dbc");
+    loads.Add(sGameObjectDisplayInfoStore, "GameObjectDisplayInfo.dbc");
+    loads.Add(sGemPropertiesStore,       "GemProperties.dbc");
+    loads.Add(sGlyphPropertiesStore,     "GlyphProperties.dbc");
+    loads.Add(sGlyphSlotStore,           "GlyphSlot.dbc");
+    loads.Add(sGtBarberShopCostBaseStore, "gtBarberShopCostBase.dbc");
+    loads.Add(sGtCombatRatingsStore,     "gtCombatRatings.dbc");
+    loads.Add(sGtChanceToMeleeCritBaseStore, "gtChanceToMeleeCritBase.dbc");
+    loads.Add(sGtChanceToMeleeCritStore, "gtChanceToMeleeCrit.dbc");
+    loads.Add(sGtChanceToSpellCritBaseStore, "gtChanceToSpellCritBase.dbc");
+    loads.Add(sGtChanceToSpellCritStore, "gtChanceToSpellCrit.dbc");
+    loads.Add(sGtOCTClassCombatRatingScalarStore, "gtOCTClassCombatRatingScalar.dbc");
+    loads.Add(sGtOCTRegenHPStore,        "gtOCTRegenHP.dbc");
+    loads.Add(sGtNPCManaCostScalerStore, "gtNPCManaCostScaler.dbc");
+    // loads.Add(sGtOCTRegenMPStore,        "gtOCTRegenMP.dbc");       -- not used currently
+    loads.Add(sGtRegenHPPerSptStore,     "gtRegenHPPerSpt.dbc");
+    loads.Add(sGtRegenMPPerSptStore,     "gtRegenMPPerSpt.dbc");
+    loads.Add(sHolidaysStore,            "Holidays.dbc");
+    loads.Add(sItemStore,                "Item.dbc");
+    loads.Add(sItemBagFamilyStore,       "ItemBagFamily.dbc");
+    loads.Add(sItemClassStore,           "ItemClass.dbc");
+    // loads.Add(sItemDisplayInfoStore,     "ItemDisplayInfo.dbc");     -- not used currently
+    // loads.Add(sItemCondExtCostsStore,    "ItemCondExtCosts.dbc");
+    loads.Add(sItemExtendedCostStore,    "ItemExtendedCost.dbc");
+    loads.Add(sItemLimitCategoryStore,   "ItemLimitCategory.dbc");
+    loads.Add(sItemRandomPropertiesStore, "ItemRandomProperties.dbc");
+    loads.Add(sItemRandomSuffixStore,    "ItemRandomSuffix.dbc");
+    loads.Add(sItemSetStore,             "ItemSet.dbc");
+    loads.Add(sLightStore,               "Light.dbc");
+    loads.Add(sLiquidTypeStore,          "LiquidType.dbc");
+    loads.Add(sLockStore,                "Lock.dbc");
+    loads.Add(sMailTemplateStore,        "MailTemplate.dbc");
+    loads.Add(sMapStore,                 "Map.dbc");
+    loads.Add(sMapDifficultyStore,       "MapDifficulty.dbc");
+    loads.Add(sMovieStore,               "Movie.dbc");
+    loads.Add(sOverrideSpellDataStore,   "OverrideSpellData.dbc");
+    loads.Add(sQuestFactionRewardStore,  "QuestFactionReward.dbc");
+    loads.Add(sQuestSortStore,           "QuestSort.dbc");
+    loads.Add(sQuestXPLevelStore,        "QuestXP.dbc");
+    loads.Add(sPowerDisplayStore,        "PowerDisplay.dbc");
+    loads.Add(sPvPDifficultyStore,       "PvpDifficulty.dbc");
+    loads.Add(sRandomPropertiesPointsStore, "RandPropPoints.dbc");
+    loads.Add(sScalingStatDistributionStore, "ScalingStatDistribution.dbc");
+    loads.Add(sScalingStatValuesStore,   "ScalingStatValues.dbc");
+    loads.Add(sSkillLineStore,           "SkillLine.dbc");
+    loads.Add(sSkillLineAbilityStore,    "SkillLineAbility.dbc");
+    loads.Add(sSkillRaceClassInfoStore,  "SkillRaceClassInfo.dbc");
+    loads.Add(sSkillTiersStore,          "SkillTiers.dbc");
+    loads.Add(sSoundEntriesStore,        "SoundEntries.dbc");
+    loads.Add(sSpellCastTimesStore,      "SpellCastTimes.dbc");
+    loads.Add(sSpellDurationStore,       "SpellDuration.dbc");
+    loads.Add(sSpellDifficultyStore,     "SpellDifficulty.dbc");
+    loads.Add(sSpellFocusObjectStore,    "SpellFocusObject.dbc");
+    loads.Add(sSpellItemEnchantmentStore, "SpellItemEnchantment.dbc");
+    loads.Add(sSpellItemEnchantmentConditionStore, "SpellItemEnchantmentCondition.dbc");
+    loads.Add(sSpellRadiusStore,         "SpellRadius.dbc");
+    loads.Add(sSpellRangeStore,          "SpellRange.dbc");
+    loads.Add(sSpellRuneCostStore,       "SpellRuneCost.dbc");
+    loads.Add(sSpellShapeshiftFormStore, "SpellShapeshiftForm.dbc");
+    loads.Add(sSpellVisualStore,         "SpellVisual.dbc");
+    loads.Add(sStableSlotPricesStore,    "StableSlotPrices.dbc");
+    loads.Add(sSummonPropertiesStore,    "SummonProperties.dbc");
+    loads.Add(sTalentStore,              "Talent.dbc");
+    loads.Add(sTalentTabStore,           "TalentTab.dbc");
+    loads.Add(sTaxiNodesStore,           "TaxiNodes.dbc");
+    loads.Add(sTaxiPathStore,            "TaxiPath.dbc");
+    loads.Add(sTaxiPathNodeStore,        "TaxiPathNode.dbc");
+    loads.Add(sTeamContributionPoints,   "TeamContributionPoints.dbc");
+    loads.Add(sTotemCategoryStore,       "TotemCategory.dbc");
+    loads.Add(sVehicleStore,             "Vehicle.dbc");
+    loads.Add(sVehicleSeatStore,         "VehicleSeat.dbc");
+    loads.Add(sWorldMapAreaStore,        "WorldMapArea.dbc");
+    loads.Add(sWMOAreaTableStore,        "WMOAreaTable.dbc");
+    loads.Add(sWorldMapOverlayStore,     "WorldMapOverlay.dbc");
+//    loads.Add(sWorldSafeLocsStore,       "WorldSafeLocs.dbc");
+
+    loads.Run(threads);
 
     // must be after sAreaStore loading
     for (uint32 i = 0; i < sAreaStore.GetNumRows(); ++i)    // areaflag numbered from 0
@@ -389,33 +552,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAchievementStore,         dbcPath, "Achievement.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAchievementCriteriaStore, dbcPath, "Achievement_Criteria.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaTriggerStore,         dbcPath, "AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAuctionHouseStore,        dbcPath, "AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBankBagSlotPricesStore,   dbcPath, "BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBattlemasterListStore,    dbcPath, "BattlemasterList.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBarberShopStyleStore,     dbcPath, "BarberShopStyle.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharStartOutfitStore,     dbcPath, "CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharTitlesStore,          dbcPath, "CharTitles.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChatChannelsStore,        dbcPath, "ChatChannels.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrClassesStore,          dbcPath, "ChrClasses.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrRacesStore,            dbcPath, "ChrRaces.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicCameraStore,     dbcPath, "CinematicCamera.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicSequencesStore,  dbcPath, "CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoStore, dbcPath, "CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoExtraStore, dbcPath, "CreatureDisplayInfoExtra.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureModelDataStore,   dbcPath, "CreatureModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureFamilyStore,      dbcPath, "CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureSpellDataStore,   dbcPath, "CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureTypeStore,        dbcPath, "CreatureType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCurrencyTypesStore,       dbcPath, "CurrencyTypes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDestructibleModelDataStore, dbcPath, "DestructibleModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityCostsStore,     dbcPath, "DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityQualityStore,   dbcPath, "DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesStore,              dbcPath, "Emotes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesTextStore,          dbcPath, "EmotesText.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionStore,             dbcPath, "Faction.dbc");
     for (uint32 i = 0; i < sFactionStore.GetNumRows(); ++i)
     {
         FactionEntry const* faction = sFactionStore.LookupEntry(i);
@@ -426,43 +562,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionTemplateStore,     dbcPath, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectDisplayInfoStore, dbcPath, "GameObjectDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGemPropertiesStore,       dbcPath, "GemProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGlyphPropertiesStore,     dbcPath, "GlyphProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGlyphSlotStore,           dbcPath, "GlyphSlot.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtBarberShopCostBaseStore, dbcPath, "gtBarberShopCostBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtCombatRatingsStore,     dbcPath, "gtCombatRatings.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritStore, dbcPath, "gtChanceToMeleeCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritStore, dbcPath, "gtChanceToSpellCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtOCTClassCombatRatingScalarStore, dbcPath, "gtOCTClassCombatRatingScalar.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtOCTRegenHPStore,        dbcPath, "gtOCTRegenHP.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtNPCManaCostScalerStore, dbcPath, "gtNPCManaCostScaler.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sGtOCTRegenMPStore,        dbcPath,"gtOCTRegenMP.dbc");       -- not used currently
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenHPPerSptStore,     dbcPath, "gtRegenHPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenMPPerSptStore,     dbcPath, "gtRegenMPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sHolidaysStore,            dbcPath, "Holidays.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemStore,                dbcPath, "Item.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemBagFamilyStore,       dbcPath, "ItemBagFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemClassStore,           dbcPath, "ItemClass.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemExtendedCostStore,    dbcPath, "ItemExtendedCost.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemLimitCategoryStore,   dbcPath, "ItemLimitCategory.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomPropertiesStore, dbcPath, "ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomSuffixStore,    dbcPath, "ItemRandomSuffix.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemSetStore,             dbcPath, "ItemSet.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLightStore,               dbcPath, "Light.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLiquidTypeStore,          dbcPath, "LiquidType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLockStore,                dbcPath, "Lock.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMailTemplateStore,        dbcPath, "MailTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapStore,                 dbcPath, "Map.dbc");
     {
         // repairs entry for netherstorm - should be moved to SQL
         MapEntry const* mEntry = sMapStore.LookupEntry(550);
@@ -472,33 +571,16 @@ void LoadDBCStores(const std::string& dataPath)
         sMapStore.InsertEntry(tempestKeepMap, 550);
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapDifficultyStore,       dbcPath, "MapDifficulty.dbc");
     // fill data
     for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
         if (MapDifficultyEntry const* entry = sMapDifficultyStore.LookupEntry(i))
             sMapDifficultyMap[MAKE_PAIR32(entry->MapId, entry->Difficulty)] = entry;
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMovieStore,               dbcPath, "Movie.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sOverrideSpellDataStore,   dbcPath, "OverrideSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestFactionRewardStore,  dbcPath, "QuestFactionReward.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestSortStore,           dbcPath, "QuestSort.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestXPLevelStore,        dbcPath, "QuestXP.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sPowerDisplayStore,        dbcPath, "PowerDisplay.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sPvPDifficultyStore,       dbcPath, "PvpDifficulty.dbc");
     for (uint32 i = 0; i < sPvPDifficultyStore.GetNumRows(); ++i)
         if (PvPDifficultyEntry const* entry = sPvPDifficultyStore.LookupEntry(i))
             if (entry->bracketId > MAX_BATTLEGROUND_BRACKETS)
                 MANGOS_ASSERT(false && "Need update MAX_BATTLEGROUND_BRACKETS by DBC data");
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sScalingStatDistributionStore, dbcPath, "ScalingStatDistribution.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sScalingStatValuesStore,   dbcPath, "ScalingStatValues.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineStore,           dbcPath, "SkillLine.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineAbilityStore,    dbcPath, "SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillRaceClassInfoStore,  dbcPath, "SkillRaceClassInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillTiersStore,          dbcPath, "SkillTiers.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSoundEntriesStore,        dbcPath, "SoundEntries.dbc");
-
     for (uint32 j = 0; j < sSkillLineAbilityStore.GetNumRows(); ++j)
     {
         SkillLineAbilityEntry const* skillLine = sSkillLineAbilityStore.LookupEntry(j);
@@ -523,11 +605,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellCastTimesStore,      dbcPath, "SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDurationStore,       dbcPath, "SpellDuration.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDifficultyStore,     dbcPath, "SpellDifficulty.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellFocusObjectStore,    dbcPath, "SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentStore, dbcPath, "SpellItemEnchantment.dbc");
     //for (uint32 i = 0; i < sSpellItemEnchantmentStore.GetNumRows(); ++i)
     //{
     //    SpellItemEnchantmentEntry const* enchantEntry = sSpellItemEnchantmentStore.LookupEntry(i);
@@ -540,15 +617,6 @@ void LoadDBCStores(const std::string& dataPath)
     //                sLog.outErrorDb("Spell ID %u found in spell item enchant %u does not exist.", enchantEntry->spellid[k], i);
     //    }
     //}
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRadiusStore,         dbcPath, "SpellRadius.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRangeStore,          dbcPath, "SpellRange.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRuneCostStore,       dbcPath, "SpellRuneCost.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellShapeshiftFormStore, dbcPath, "SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellVisualStore,         dbcPath, "SpellVisual.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sStableSlotPricesStore,    dbcPath, "StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSummonPropertiesStore,    dbcPath, "SummonProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentStore,              dbcPath, "Talent.dbc");
 
     // create talent spells set
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -560,8 +628,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i, j);
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentTabStore,           dbcPath, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // now have all max ranks (and then bit amount used for store talent ranks in inspect)
@@ -583,16 +649,12 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiNodesStore,           dbcPath, "TaxiNodes.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathStore,            dbcPath, "TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID, entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
     //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathNodeStore,        dbcPath, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -662,12 +724,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTeamContributionPoints,   dbcPath, "TeamContributionPoints.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTotemCategoryStore,       dbcPath, "TotemCategory.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sVehicleStore,             dbcPath, "Vehicle.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sVehicleSeatStore,         dbcPath, "VehicleSeat.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapAreaStore,        dbcPath, "WorldMapArea.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWMOAreaTableStore,        dbcPath, "WMOAreaTable.dbc");
     for (uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if (WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -675,9 +731,6 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple.insert(WMOAreaInfoByTripple::value_type(WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId), entry));
         }
     }
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapOverlayStore,     dbcPath, "WorldMapOverlay.dbc");
-//    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldSafeLocsStore,       dbcPath, "WorldSafeLocs.dbc");
-
     // error checks
     if (bad_dbc_files.size() >= DBCFilesCount)
     {
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/WorldPacketPool.h"
+#include "Policies/Singleton.h"
+
+INSTANTIATE_SINGLETON_1(WorldPacketPool);
+
+// client packets are limited to 0x2800 bytes, see WorldSocket::ProcessIncomingData
+static size_t const s_classSizes[WORLD_PACKET_POOL_CLASSES] = { 64, 256, 1024, 4096, 0x2800 };
+
+int WorldPacketPool::GetSizeClass(size_t size)
+{
+    for (int i = 0; i < WORLD_PACKET_POOL_CLASSES; ++i)
+        if (size <= s_classSizes[i])
+            return i;
+
+    return -1;
+}
+
+std::unique_ptr<WorldPacket> WorldPacketPool::Acquire(Opcodes opcode, size_t size)
+{
+    int index = GetSizeClass(size);
+    if (index < 0)
+        return std::unique_ptr<WorldPacket>(new WorldPacket(opcode, size));
+
+    SizeClass& sizeClass = m_classes[index];
+    {
+        std::lock_guard<std::mutex> guard(sizeClass.lock);
+        if (!sizeClass.packets.empty())
+        {
+            std::unique_ptr<WorldPacket> packet = std::move(sizeClass.packets.back());
+            sizeClass.packets.pop_back();
+            packet->SetOpcode(opcode);
+            return packet;
+        }
+    }
+
+    return std::unique_ptr<WorldPacket>(new WorldPacket(opcode, s_classSizes[index]));
+}
+
+void WorldPacketPool::Release(std::unique_ptr<WorldPacket> packet)
+{
+    // a packet is put back into the largest class its storage still covers
+    size_t capacity = packet->capacity();
+    if (capacity > 4 * s_classSizes[WORLD_PACKET_POOL_CLASSES - 1])
+        return;
+
+    int index = WORLD_PACKET_POOL_CLASSES - 1;
+    while (index >= 0 && capacity < s_classSizes[index])
+        --index;
+
+    if (index < 0)
+        return;
+
+    packet->clear();
+
+    SizeClass& sizeClass = m_classes[index];
+    std::lock_guard<std::mutex> guard(sizeClass.lock);
+    if (sizeClass.packets.size() < WORLD_PACKET_POOL_CLASS_LIMIT)
+        sizeClass.packets.push_back(std::move(packet));
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLDPACKETPOOL_H
+#define MANGOS_WORLDPACKETPOOL_H
+
+#include "Common.h"
+#include "WorldPacket.h"
+#include "Policies/Singleton.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define WORLD_PACKET_POOL_CLASSES       5
+#define WORLD_PACKET_POOL_CLASS_LIMIT   1024            // kept packets per size class
+
+// Recycles storage of received packets, they are allocated by network threads and freed by world/map threads
+class WorldPacketPool
+{
+    public:
+        WorldPacketPool() {}
+        WorldPacketPool(const WorldPacketPool&) = delete;
+
+        // empty packet with at least size bytes reserved
+        std::unique_ptr<WorldPacket> Acquire(Opcodes opcode, size_t size);
+        void Release(std::unique_ptr<WorldPacket> packet);
+
+    private:
+        struct SizeClass
+        {
+            std::mutex lock;
+            std::vector<std::unique_ptr<WorldPacket>> packets;
+        };
+
+        static int GetSizeClass(size_t size);
+
+        SizeClass m_classes[WORLD_PACKET_POOL_CLASSES];
+};
+
+#define sWorldPacketPool MaNGOS::Singleton<WorldPacketPool>::Instance()
+
+#endif
@@ -29,6 +29,7 @@
 #include "Server/Opcodes.h"
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
+#include "Server/WorldPacketPool.h"
 #include "Entities/Player.h"
 #include "Globals/ObjectMgr.h"
 #include "Groups/Group.h"
@@ -227,11 +228,27 @@ void WorldSession::SendPacket(WorldPacket const& packet) const
     m_Socket->SendPacket(packet);
 }
 
+void WorldSession::SendPacket(std::shared_ptr<const WorldPacket> const& packet) const
+{
+#ifdef BUILD_PLAYERBOT
+    // bots inspect outgoing packets
+    if (GetPlayer() && (GetPlayer()->GetPlayerbotAI() || GetPlayer()->GetPlayerbotMgr()))
+    {
+        SendPacket(*packet);
+        return;
+    }
+#endif
+
+    if (!m_Socket || m_Socket->IsClosed())
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
-    m_recvQueue.push_back(std::move(new_packet));
+    m_recvQueue.Push(std::move(new_packet));
 }
 
 /// Logging helper for unexpected opcodes
@@ -259,10 +276,13 @@ bool WorldSession::Update(PacketFilter& updater)
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    while (m_Socket && !m_Socket->IsClosed() && !m_recvQueue.empty())
+    while (m_Socket && !m_Socket->IsClosed())
     {
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
+        WorldPacket* next = m_recvQueue.Peek();
+        if (!next)
+            break;
+
+        std::unique_ptr<WorldPacket> packet = m_recvQueue.Pop();
 
         /*#if 1
         sLog.outError( "MOEP: %s (0x%.4X)",
@@ -359,6 +379,8 @@ bool WorldSession::Update(PacketFilter& updater)
                 KickPlayer();
             }
         }
+
+        sWorldPacketPool.Release(std::move(packet));
     }
 
 #ifdef BUILD_PLAYERBOT
@@ -373,15 +395,11 @@ bool WorldSession::Update(PacketFilter& updater)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            while (std::unique_ptr<WorldPacket> botpacket = pBotWorldSession->m_recvQueue.Pop())
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
-
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
             }
-            pBotWorldSession->m_recvQueue.clear();
         }
     }
 #endif
@@ -29,6 +29,7 @@
 #include "AuctionHouse/AuctionHouseMgr.h"
 #include "Entities/Item.h"
 #include "Server/WorldSocket.h"
+#include "MPSCQueue.h"
 
 #include <deque>
 #include <mutex>
@@ -289,6 +290,8 @@ class WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const& packet) const;
+        // packet sent to many sessions, its content is shared instead of copied for each of them
+        void SendPacket(std::shared_ptr<const WorldPacket> const& packet) const;
         void SendExpectedSpamRecords();
         void SendMotd();
         void SendOfflineNameQueryResponses();
@@ -419,8 +422,8 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction) const;
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         static void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-                                   uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const;
+        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, uint32 listfrom, uint32 usable,
+                                   uint32& count, uint32& totalcount, bool isFull) const;
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid) const;
 
@@ -987,8 +990,8 @@ class WorldSession
         std::set<ObjectGuid> m_offlineNameQueries; // for name queires made when not logged in (character selection screen)
         std::deque<CharacterNameQueryResponse> m_offlineNameResponses; // for responses to name queries made when not logged in
 
-        std::mutex m_recvQueueLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
+        std::mutex m_recvQueueLock;                         // consumer side only, network threads push lock-free
+        MPSCQueue<WorldPacket> m_recvQueue;
 };
 #endif
 /// @}
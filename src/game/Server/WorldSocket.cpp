@@ -28,6 +28,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Auth/Sha1.h"
 #include "Server/WorldSession.h"
+#include "Server/WorldPacketPool.h"
 #include "Log.h"
 #include "Server/DBCStores.h"
 
@@ -89,6 +90,10 @@ WorldSocket::WorldSocket(boost::asio::io_service& service, std::function<void (S
 {
 }
 
+WorldSocket::~WorldSocket()
+{
+}
+
 void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
 {
     if (IsClosed())
@@ -109,6 +114,27 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
         ForceFlushOut();
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<const WorldPacket> const& pct, bool immediate)
+{
+    if (IsClosed())
+        return;
+
+    // Dump outgoing packet.
+    sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, false);
+
+    ServerPktHeader header(pct->size() + 2, pct->GetOpcode());
+    m_crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
+
+    // only the header is encrypted, content stays shared
+    if (!pct->empty())
+        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength(), std::shared_ptr<const uint8>(pct, pct->contents()), pct->size());
+    else
+        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength());
+
+    if (immediate)
+        ForceFlushOut();
+}
+
 bool WorldSocket::Open()
 {
     if (!Socket::Open())
@@ -190,7 +216,7 @@ bool WorldSocket::ProcessIncomingData()
     if (IsClosed())
         return false;
 
-    std::unique_ptr<WorldPacket> pct(new WorldPacket(opcode, validBytesRemaining));
+    std::unique_ptr<WorldPacket> pct = sWorldPacketPool.Acquire(opcode, validBytesRemaining);
 
     if (validBytesRemaining)
     {
@@ -211,7 +237,7 @@ bool WorldSocket::ProcessIncomingData()
                     return false;
                 }
 
-                return HandleAuthSession(*pct);
+                return HandleAuthSession(std::move(pct));
 
             case CMSG_PING:
                 return HandlePing(*pct);
@@ -257,34 +283,51 @@ bool WorldSocket::ProcessIncomingData()
     return true;
 }
 
-bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
+bool WorldSocket::AsyncQuery(QueryHandler handler, const char* format, ...)
+{
+    // other sockets of this network thread are served meanwhile
+    SuspendRead();
+
+    std::shared_ptr<WorldSocket> self = shared<WorldSocket>();
+    va_list ap;
+    va_start(ap, format);
+    bool queued = LoginDatabase.AsyncVPQuery([self, handler](QueryResult* result)
+    {
+        std::shared_ptr<QueryResult> resultHolder(result);
+        self->ResumeRead([self, handler, resultHolder]() { return (self.get()->*handler)(resultHolder.get()); });
+    }, format, ap);
+    va_end(ap);
+
+    // the authentication can't continue without the result
+    if (!queued)
+        Close();
+
+    return queued;
+}
+
+bool WorldSocket::HandleAuthSession(std::unique_ptr<WorldPacket> recvPacket)
 {
     // NOTE: ATM the socket is singlethread, have this in mind ...
-    uint8 digest[20];
-    uint32 clientSeed;
     uint32 ClientBuild;
-    LocaleConstant locale;
-    std::string account;
-    Sha1Hash sha1;
-    BigNumber v, s, g, N, K;
+    std::unique_ptr<AuthSessionRequest> request(new AuthSessionRequest);
     WorldPacket packet;
 
     // Read the content of the packet
-    recvPacket >> ClientBuild;
-    recvPacket.read_skip<uint32>();
-    recvPacket >> account;
-    recvPacket.read_skip<uint32>();
-    recvPacket >> clientSeed;
-    recvPacket.read_skip<uint32>();
-    recvPacket.read_skip<uint32>();
-    recvPacket.read_skip<uint32>();
-    recvPacket.read_skip<uint64>();
-    recvPacket.read(digest, 20);
+    *recvPacket >> ClientBuild;
+    recvPacket->read_skip<uint32>();
+    *recvPacket >> request->account;
+    recvPacket->read_skip<uint32>();
+    *recvPacket >> request->clientSeed;
+    recvPacket->read_skip<uint32>();
+    recvPacket->read_skip<uint32>();
+    recvPacket->read_skip<uint32>();
+    recvPacket->read_skip<uint64>();
+    recvPacket->read(request->digest, 20);
 
     DEBUG_LOG("WorldSocket::HandleAuthSession: client build %u, account %s, clientseed %X",
               ClientBuild,
-              account.c_str(),
-              clientSeed);
+              request->account.c_str(),
+              request->clientSeed);
 
     // Check the version of client trying to connect
     if (!IsAcceptableClientBuild(ClientBuild))
@@ -299,25 +342,34 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     }
 
     // Get the account information from the realmd database
-    std::string safe_account = account; // Duplicate, else will screw the SHA hash verification below
+    std::string safe_account = request->account; // Duplicate, else will screw the SHA hash verification below
     LoginDatabase.escape_string(safe_account);
+
+    request->packet = std::move(recvPacket);
+    m_authRequest = std::move(request);
+
     // No SQL injection, username escaped.
+    return AsyncQuery(&WorldSocket::HandleAuthSessionAccount,
+                      "SELECT "
+                      "id, "                      //0
+                      "gmlevel, "                 //1
+                      "sessionkey, "              //2
+                      "last_ip, "                 //3
+                      "locked, "                  //4
+                      "v, "                       //5
+                      "s, "                       //6
+                      "expansion, "               //7
+                      "mutetime, "                //8
+                      "locale "                   //9
+                      "FROM account "
+                      "WHERE username = '%s'",
+                      safe_account.c_str());
+}
 
-    QueryResult* result =
-        LoginDatabase.PQuery("SELECT "
-                             "id, "                      //0
-                             "gmlevel, "                 //1
-                             "sessionkey, "              //2
-                             "last_ip, "                 //3
-                             "locked, "                  //4
-                             "v, "                       //5
-                             "s, "                       //6
-                             "expansion, "               //7
-                             "mutetime, "                //8
-                             "locale "                   //9
-                             "FROM account "
-                             "WHERE username = '%s'",
-                             safe_account.c_str());
+bool WorldSocket::HandleAuthSessionAccount(QueryResult* result)
+{
+    BigNumber v, s;
+    WorldPacket packet;
 
     // Stop if the account is not found
     if (!result)
@@ -333,9 +385,6 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 
     Field* fields = result->Fetch();
 
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
-
     v.SetHexStr(fields[5].GetString());
     s.SetHexStr(fields[6].GetString());
     m_s = s;
@@ -359,57 +408,74 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
             packet << uint8(AUTH_FAILED);
             SendPacket(packet);
 
-            delete result;
             BASIC_LOG("WorldSocket::HandleAuthSession: Sent Auth Response (Account IP differs).");
             return false;
         }
     }
 
-    uint32 id = fields[0].GetUInt32();
-    uint32 security = fields[1].GetUInt16();
-    if (security > SEC_ADMINISTRATOR)                       // prevent invalid security settings in DB
-        security = SEC_ADMINISTRATOR;
+    AuthSessionRequest& request = *m_authRequest;
+
+    request.id = fields[0].GetUInt32();
+    request.security = fields[1].GetUInt16();
+    if (request.security > SEC_ADMINISTRATOR)               // prevent invalid security settings in DB
+        request.security = SEC_ADMINISTRATOR;
 
     uint8 maxServerExpansion = sWorld.getConfig(CONFIG_UINT32_EXPANSION);
     uint8 currentServerExpansion = sWorldState.GetExpansion();
     uint8 playerAddonLevel = fields[7].GetUInt8();
-    uint8 expansion;
-    if (security >= SEC_GAMEMASTER)
-        expansion = std::min(playerAddonLevel, maxServerExpansion);
+    if (request.security >= SEC_GAMEMASTER)
+        request.expansion = std::min(playerAddonLevel, maxServerExpansion);
     else
-        expansion = std::min(playerAddonLevel, currentServerExpansion);
+        request.expansion = std::min(playerAddonLevel, currentServerExpansion);
 
-    K.SetHexStr(fields[2].GetString());
+    request.K.SetHexStr(fields[2].GetString());
 
-    time_t mutetime = time_t (fields[8].GetUInt64());
+    request.mutetime = time_t (fields[8].GetUInt64());
 
     uint8 tempLoc = LocaleConstant(fields[9].GetUInt8());
     if (tempLoc >= static_cast<uint8>(MAX_LOCALE))
-        locale = LOCALE_enUS;
+        request.locale = LOCALE_enUS;
     else
-        locale = LocaleConstant(tempLoc);
+        request.locale = LocaleConstant(tempLoc);
+
+    // Re-check account ban (same check as in realmd), recent results are reused
+    bool banned;
+    if (sWorld.GetCachedBanState(request.id, GetRemoteAddress(), banned))
+        return CompleteAuthSession(banned);
+
+    return AsyncQuery(&WorldSocket::HandleAuthSessionBanCheck,
+                      "SELECT 1 FROM account_banned WHERE account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)"
+                      "UNION "
+                      "SELECT 1 FROM ip_banned WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'",
+                      request.id, GetRemoteAddress().c_str());
+}
 
-    delete result;
+bool WorldSocket::HandleAuthSessionBanCheck(QueryResult* result)
+{
+    bool banned = result != nullptr;
+    sWorld.CacheBanState(m_authRequest->id, GetRemoteAddress(), banned);
+
+    return CompleteAuthSession(banned);
+}
 
-    // Re-check account ban (same check as in realmd)
-    QueryResult* banresult =
-        LoginDatabase.PQuery("SELECT 1 FROM account_banned WHERE account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)"
-                             "UNION "
-                             "SELECT 1 FROM ip_banned WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'",
-                             id, GetRemoteAddress().c_str());
+bool WorldSocket::CompleteAuthSession(bool banned)
+{
+    std::unique_ptr<AuthSessionRequest> request = std::move(m_authRequest);
+    WorldPacket packet;
 
-    if (banresult) // if account banned
+    if (banned) // if account banned
     {
         packet.Initialize(SMSG_AUTH_RESPONSE, 1);
         packet << uint8(AUTH_BANNED);
         SendPacket(packet);
 
-        delete banresult;
-
         sLog.outError("WorldSocket::HandleAuthSession: Sent Auth Response (Account banned).");
         return false;
     }
 
+    uint32 id = request->id;
+    uint32 security = request->security;
+
     // Check locked state for server
     AccountTypes allowedAccountType = sWorld.GetPlayerSecurityLimit();
 
@@ -430,14 +496,14 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     uint32 t = 0;
     uint32 seed = m_seed;
 
-    sha.UpdateData(account);
+    sha.UpdateData(request->account);
     sha.UpdateData((uint8*) & t, 4);
-    sha.UpdateData((uint8*) & clientSeed, 4);
+    sha.UpdateData((uint8*) & request->clientSeed, 4);
     sha.UpdateData((uint8*) & seed, 4);
-    sha.UpdateBigNumbers(&K, nullptr);
+    sha.UpdateBigNumbers(&request->K, nullptr);
     sha.Finalize();
 
-    if (memcmp(sha.GetDigest(), digest, 20))
+    if (memcmp(sha.GetDigest(), request->digest, 20))
     {
         packet.Initialize(SMSG_AUTH_RESPONSE, 1);
         packet << uint8(AUTH_FAILED);
@@ -451,7 +517,7 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     const std::string& address = GetRemoteAddress();
 
     DEBUG_LOG("WorldSocket::HandleAuthSession: Client '%s' authenticated successfully from %s.",
-              account.c_str(),
+              request->account.c_str(),
               address.c_str());
 
     // Update the last_ip in the database
@@ -459,9 +525,9 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     static SqlStatementID updAccount;
 
     SqlStatement stmt = LoginDatabase.CreateStatement(updAccount, "UPDATE account SET last_ip = ? WHERE username = ?");
-    stmt.PExecute(address.c_str(), account.c_str());
+    stmt.PExecute(address.c_str(), request->account.c_str());
 
-    m_crypt.Init(&K);
+    m_crypt.Init(&request->K);
 
     m_session = sWorld.FindSession(id);
     if (m_session)
@@ -484,12 +550,20 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     else
     {
         // new session
-        if (!(m_session = new WorldSession(id, this, AccountTypes(security), expansion, mutetime, locale)))
+        if (!(m_session = new WorldSession(id, this, AccountTypes(security), request->expansion, request->mutetime, request->locale)))
             return false;
 
         m_session->LoadGlobalAccountData();
         m_session->LoadTutorialsData();
-        m_session->ReadAddonsInfo(recvPacket);
+        // not handled by the packet exception handling of ProcessIncomingData() anymore at this point
+        try
+        {
+            m_session->ReadAddonsInfo(*request->packet);
+        }
+        catch (ByteBufferException&)
+        {
+            sLog.outError("WorldSocket::HandleAuthSession: ByteBufferException occured while reading addon info of account %u from %s.", id, address.c_str());
+        }
 
         sWorld.AddSession(m_session);
     }
@@ -32,9 +32,11 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 
 class WorldPacket;
 class WorldSession;
+class QueryResult;
 
 /**
  * WorldSocket.
@@ -111,20 +113,53 @@ class WorldSocket : public MaNGOS::Socket
 
         BigNumber m_s;
 
+        /// CMSG_AUTH_SESSION being handled while the login database is queried
+        struct AuthSessionRequest
+        {
+            std::unique_ptr<WorldPacket> packet;            // read up to the addon info
+            std::string account;
+            uint32 clientSeed;
+            uint8 digest[20];
+
+            // account data
+            uint32 id;
+            uint32 security;
+            uint8 expansion;
+            time_t mutetime;
+            LocaleConstant locale;
+            BigNumber K;
+        };
+
+        std::unique_ptr<AuthSessionRequest> m_authRequest;
+
+        typedef bool (WorldSocket::*QueryHandler)(QueryResult* result);
+
+        /// Reading is suspended until the handler continues with the result on the network thread.
+        bool AsyncQuery(QueryHandler handler, const char* format, ...) ATTR_PRINTF(3, 4);
+
         /// process one incoming packet.
         virtual bool ProcessIncomingData() override;
 
         /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
-        bool HandleAuthSession(WorldPacket& recvPacket);
+        bool HandleAuthSession(std::unique_ptr<WorldPacket> recvPacket);
+        /// Continue CMSG_AUTH_SESSION with the account data.
+        bool HandleAuthSessionAccount(QueryResult* result);
+        /// Continue CMSG_AUTH_SESSION with the ban check.
+        bool HandleAuthSessionBanCheck(QueryResult* result);
+        bool CompleteAuthSession(bool banned);
 
         /// Called by ProcessIncoming() on CMSG_PING.
         bool HandlePing(WorldPacket& recvPacket);
 
     public:
         WorldSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler);
+        // defined where WorldPacket is complete, m_authRequest owns one
+        ~WorldSocket();
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct, bool immediate = false);
+        // packet content is sent without copying, the same packet may be sent to many sockets
+        void SendPacket(std::shared_ptr<const WorldPacket> const& pct, bool immediate = false);
 
         void FinalizeSession() { m_session = nullptr; }
 
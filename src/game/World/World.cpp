@@ -21,6 +21,7 @@
 */
 
 #include "World/World.h"
+#include "World/WorldLoader.h"
 #include "Database/DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
@@ -477,6 +478,8 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_BOOL_COMPRESSION_ADAPTIVE, "Compression.Adaptive", false);
+    setConfigMin(CONFIG_UINT32_COMPRESSION_ADAPTIVE_SIZE, "Compression.Adaptive.Size", 16384, 100);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -617,6 +620,16 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_LOAD_THREADS, "LoadThreads", 0);
+    setConfig(CONFIG_BOOL_DBC_MEMORY_MAPPED, "DBC.MemoryMapped", false);
+    setConfig(CONFIG_BOOL_GRIDMAP_MEMORY_MAPPED, "GridMap.MemoryMapped", false);
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreload.Threads", 0);
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreload.Lookahead", 10);
+    setConfig(CONFIG_BOOL_MAP_UPDATE_PARTITIONED, "MapUpdate.Partitioned", false);
+    setConfig(CONFIG_UINT32_MAP_UPDATE_PARTITION_MIN_OBJECTS, "MapUpdate.Partitioned.MinObjects", 500);
+    setConfig(CONFIG_BOOL_MAP_UPDATE_THREAD_AFFINITY, "MapUpdate.ThreadAffinity", false);
+    setConfig(CONFIG_BOOL_OBJECT_UPDATE_PARALLEL, "ObjectUpdate.Parallel", false);
+    setConfig(CONFIG_UINT32_OBJECT_UPDATE_PARALLEL_MIN_OBJECTS, "ObjectUpdate.Parallel.MinObjects", 200);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -644,6 +657,8 @@ void World::LoadConfigSettings(bool reload)
         setConfig(CONFIG_UINT32_MAX_OVERSPEED_PINGS, 2);
     }
 
+    setConfig(CONFIG_UINT32_BAN_CHECK_CACHE_TIME, "BanCheckCacheTime", 30);
+
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
@@ -865,12 +880,16 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
+    setConfig(CONFIG_BOOL_MMAP_MEMORY_MAPPED, "mmap.memoryMapped", false);
+    setConfig(CONFIG_UINT32_MMAP_TILE_CACHE_SIZE, "mmap.tileCacheSize", 64);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_BOOL_PATH_FIND_ASYNC, "PathFinder.Async", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 0);
 
     sLog.outString();
 }
@@ -939,7 +958,7 @@ void World::SetInitialWorldSettings()
     
     ///- Load the DBC files
     sLog.outString("Initialize DBC data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, getConfig(CONFIG_UINT32_LOAD_THREADS), getConfig(CONFIG_BOOL_DBC_MEMORY_MAPPED));
     DetectDBCLang();
     sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
 
@@ -976,105 +995,52 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Checking Spell Cone Data...");
-    sObjectMgr.CheckSpellCones();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature cooldowns...");
-    sObjectMgr.LoadCreatureCooldowns();
-
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString("Loading Vehicle Accessory...");         // must be after LoadCreatureTemplates
-    sObjectMgr.LoadVehicleAccessory();
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Creature Conditional Spawn Data...");  // must be after LoadCreatureTemplates and before LoadCreatures
-    sObjectMgr.LoadCreatureConditionalSpawn();
-
-    sLog.outString("Loading Creature Spawn Entry Data..."); // must be before LoadCreatures
-    sObjectMgr.LoadCreatureSpawnEntry();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
+    ///- Load the static world data, steps not depending on each other may run concurrently
+    WorldLoader loader;
+    loader.AddStep("Page Texts", []() { sObjectMgr.LoadPageTexts(); });
+    loader.AddStep("Game Object Templates", []() { sObjectMgr.LoadGameobjectInfo(); }, { "Page Texts" });
+    loader.AddStep("GameObject models", []() { LoadGameObjectModelList(); });
+
+    // spell data loaders use each others data through SpellMgr helpers, keep them in sequence
+    loader.AddStep("Spell Chain Data", []() { sSpellMgr.LoadSpellChains(); });
+    loader.AddStep("Spell Cone Data checks", []() { sObjectMgr.CheckSpellCones(); }, { "Spell Chain Data" });
+    loader.AddStep("Spell Elixir types", []() { sSpellMgr.LoadSpellElixirs(); }, { "Spell Cone Data checks" });
+    loader.AddStep("Spell Learn Skills", []() { sSpellMgr.LoadSpellLearnSkills(); }, { "Spell Elixir types" });
+    loader.AddStep("Spell Learn Spells", []() { sSpellMgr.LoadSpellLearnSpells(); }, { "Spell Learn Skills" });
+    loader.AddStep("Spell Proc Event conditions", []() { sSpellMgr.LoadSpellProcEvents(); }, { "Spell Learn Spells" });
+    loader.AddStep("Spell Bonus Data", []() { sSpellMgr.LoadSpellBonuses(); }, { "Spell Proc Event conditions" });
+    loader.AddStep("Spell Proc Item Enchant", []() { sSpellMgr.LoadSpellProcItemEnchant(); }, { "Spell Bonus Data" });
+    loader.AddStep("Aggro Spells Definitions", []() { sSpellMgr.LoadSpellThreats(); }, { "Spell Proc Item Enchant" });
+
+    loader.AddStep("NPC Texts", []() { sObjectMgr.LoadGossipText(); });
+
+    loader.AddStep("Item Random Enchantments Table", []() { LoadRandomEnchantmentsTable(); });
+    loader.AddStep("Item Templates", []() { sObjectMgr.LoadItemPrototypes(); }, { "Item Random Enchantments Table", "Page Texts" });
+    loader.AddStep("Item converts", []() { sObjectMgr.LoadItemConverts(); }, { "Item Templates" });
+    loader.AddStep("Item expire converts", []() { sObjectMgr.LoadItemExpireConverts(); }, { "Item Templates" });
+
+    loader.AddStep("Creature Model Based Info Data", []() { sObjectMgr.LoadCreatureModelInfo(); });
+    loader.AddStep("Equipment templates", []() { sObjectMgr.LoadEquipmentTemplates(); });
+    loader.AddStep("Creature Stats", []() { sObjectMgr.LoadCreatureClassLvlStats(); });
+    loader.AddStep("Creature templates", []() { sObjectMgr.LoadCreatureTemplates(); }, { "Creature Model Based Info Data", "Equipment templates", "Creature Stats" });
+    loader.AddStep("Creature template spells", []() { sObjectMgr.LoadCreatureTemplateSpells(); }, { "Creature templates" });
+    loader.AddStep("Creature cooldowns", []() { sObjectMgr.LoadCreatureCooldowns(); }, { "Creature templates" });
+    loader.AddStep("Creature Model for race", []() { sObjectMgr.LoadCreatureModelRace(); }, { "Creature templates" });
+    loader.AddStep("Vehicle Accessory", []() { sObjectMgr.LoadVehicleAccessory(); }, { "Creature templates" });
+    loader.AddStep("ItemRequiredTarget", []() { sObjectMgr.LoadItemRequiredTarget(); }, { "Item Templates", "Creature templates" });
+
+    loader.AddStep("Reputation Reward Rates", []() { sObjectMgr.LoadReputationRewardRate(); });
+    loader.AddStep("Creature Reputation OnKill Data", []() { sObjectMgr.LoadReputationOnKill(); }, { "Creature templates" });
+    loader.AddStep("Reputation Spillover Data", []() { sObjectMgr.LoadReputationSpilloverTemplate(); });
+    loader.AddStep("Points Of Interest Data", []() { sObjectMgr.LoadPointsOfInterest(); });
+
+    loader.AddStep("Creature Conditional Spawn Data", []() { sObjectMgr.LoadCreatureConditionalSpawn(); }, { "Creature templates" });
+    loader.AddStep("Creature Spawn Entry Data", []() { sObjectMgr.LoadCreatureSpawnEntry(); }, { "Creature templates" });
+    loader.AddStep("Creature Data", []() { sObjectMgr.LoadCreatures(); },
+                   { "Creature Model Based Info Data", "Equipment templates", "Creature templates", "Creature Conditional Spawn Data", "Creature Spawn Entry Data" });
+
+    loader.Run(getConfig(CONFIG_UINT32_LOAD_THREADS));
+    loader.PrintTimings(10);
 
     sLog.outString("Loading SpellsScriptTarget...");
     sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates, LoadCreatures and LoadGameobjectInfo
@@ -1846,6 +1812,7 @@ BanReturn World::BanAccount(WorldSession *session, uint32 duration_secs, const s
         LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active) VALUES ('%u', UNIX_TIMESTAMP(), 0, '%s', '%s', '1')",
             session->GetAccountId(), author.c_str(), reason.c_str());
 
+    ClearBanCache();
     session->KickPlayer();
     return BAN_SUCCESS;
 }
@@ -1880,6 +1847,8 @@ BanReturn World::BanAccount(BanMode mode, std::string nameOrIP, uint32 duration_
             return BAN_SYNTAX_ERROR;
     }
 
+    ClearBanCache();
+
     if (!resultAccounts)
     {
         if (mode == BAN_IP)
@@ -1934,9 +1903,60 @@ bool World::RemoveBanAccount(BanMode mode, const std::string& source, const std:
         LoginDatabase.PExecute("UPDATE account_banned SET active = '0', unbanned_at = UNIX_TIMESTAMP(), unbanned_by = '%s' WHERE account_id = '%u'", source.data(), account);
         WarnAccount(account, source, message, "UNBAN");
     }
+
+    ClearBanCache();
     return true;
 }
 
+bool World::GetCachedBanState(uint32 accountId, const std::string& address, bool& banned)
+{
+    std::lock_guard<std::mutex> guard(m_banCacheLock);
+
+    auto itr = m_banCache.find(std::make_pair(accountId, address));
+    if (itr == m_banCache.end())
+        return false;
+
+    if (itr->second.first <= time(nullptr))
+    {
+        m_banCache.erase(itr);
+        return false;
+    }
+
+    banned = itr->second.second;
+    return true;
+}
+
+void World::CacheBanState(uint32 accountId, const std::string& address, bool banned)
+{
+    uint32 cacheTime = getConfig(CONFIG_UINT32_BAN_CHECK_CACHE_TIME);
+    if (!cacheTime)
+        return;
+
+    time_t now = time(nullptr);
+
+    std::lock_guard<std::mutex> guard(m_banCacheLock);
+
+    // drop expired entries once in a while instead of keeping every address ever seen
+    if (m_banCache.size() >= 1024)
+    {
+        for (auto itr = m_banCache.begin(); itr != m_banCache.end();)
+        {
+            if (itr->second.first <= now)
+                itr = m_banCache.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
+    m_banCache[std::make_pair(accountId, address)] = std::make_pair(now + cacheTime, banned);
+}
+
+void World::ClearBanCache()
+{
+    std::lock_guard<std::mutex> guard(m_banCacheLock);
+    m_banCache.clear();
+}
+
 /// Update the game time
 void World::_UpdateGameTime()
 {
@@ -29,6 +29,7 @@
 #include "Entities/Object.h"
 
 #include <set>
+#include <map>
 #include <list>
 #include <deque>
 #include <mutex>
@@ -88,6 +89,7 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_ADAPTIVE_SIZE,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
@@ -138,6 +140,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_LOAD_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_UINT32_MMAP_TILE_CACHE_SIZE,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
+    CONFIG_UINT32_MAP_UPDATE_PARTITION_MIN_OBJECTS,
+    CONFIG_UINT32_OBJECT_UPDATE_PARALLEL_MIN_OBJECTS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -150,6 +159,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_SKILL_GAIN_GATHERING,
     CONFIG_UINT32_SKILL_GAIN_WEAPON,
     CONFIG_UINT32_MAX_OVERSPEED_PINGS,
+    CONFIG_UINT32_BAN_CHECK_CACHE_TIME,
     CONFIG_UINT32_EXPANSION,
     CONFIG_UINT32_CHATFLOOD_MESSAGE_COUNT,
     CONFIG_UINT32_CHATFLOOD_MESSAGE_DELAY,
@@ -295,6 +305,7 @@ enum eConfigFloatValues
 enum eConfigBoolValues
 {
     CONFIG_BOOL_GRID_UNLOAD = 0,
+    CONFIG_BOOL_COMPRESSION_ADAPTIVE,
     CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY,
     CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET,
     CONFIG_BOOL_ALLOW_TWO_SIDE_ACCOUNTS,
@@ -362,9 +373,16 @@ enum eConfigBoolValues
     CONFIG_BOOL_PET_ATTACK_FROM_BEHIND,
     CONFIG_BOOL_AUTO_DOWNRANK,
     CONFIG_BOOL_MMAP_ENABLED,
+    CONFIG_BOOL_MMAP_MEMORY_MAPPED,
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_PATH_FIND_ASYNC,
+    CONFIG_BOOL_MAP_UPDATE_PARTITIONED,
+    CONFIG_BOOL_MAP_UPDATE_THREAD_AFFINITY,
+    CONFIG_BOOL_OBJECT_UPDATE_PARALLEL,
+    CONFIG_BOOL_DBC_MEMORY_MAPPED,
+    CONFIG_BOOL_GRIDMAP_MEMORY_MAPPED,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -584,6 +602,9 @@ class World
         BanReturn BanAccount(BanMode mode, std::string nameOrIP, uint32 duration_secs, std::string reason, const std::string& author);
         BanReturn BanAccount(WorldSession *session, uint32 duration_secs, const std::string& reason, const std::string& author);
         bool RemoveBanAccount(BanMode mode, const std::string& source, const std::string& message, std::string nameOrIP);
+        // ban check results at session authentication, kept for a short time for clients reconnecting in bursts
+        bool GetCachedBanState(uint32 accountId, const std::string& address, bool& banned);
+        void CacheBanState(uint32 accountId, const std::string& address, bool banned);
 
         // for max speed access
         static float GetMaxVisibleDistanceOnContinents()    { return m_MaxVisibleDistanceOnContinents; }
@@ -719,6 +740,12 @@ class World
         std::mutex m_sessionAddQueueLock;
         std::deque<WorldSession*> m_sessionAddQueue;
 
+        // cached ban check results by account and address: expire time and banned state
+        void ClearBanCache();
+
+        std::mutex m_banCacheLock;
+        std::map<std::pair<uint32, std::string>, std::pair<time_t, bool>> m_banCache;
+
         // used versions
         std::string m_DBVersion;
         std::string m_CreatureEventAIVersion;
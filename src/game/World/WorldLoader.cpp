@@ -0,0 +1,150 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoader.h"
+#include "Log.h"
+#include "Timer.h"
+#include "ProgressBar.h"
+#include "Database/DatabaseEnv.h"
+
+#include <algorithm>
+#include <thread>
+
+void WorldLoader::AddStep(char const* name, LoadFunction function, std::vector<char const*> const& dependencies)
+{
+    Step step;
+    step.name = name;
+    step.function = function;
+    step.pendingDependencies = 0;
+    step.startTime = 0;
+    step.duration = 0;
+
+    size_t index = m_steps.size();
+    for (char const* dependency : dependencies)
+    {
+        std::vector<Step>::iterator itr = std::find_if(m_steps.begin(), m_steps.end(), [dependency](Step const& added) { return added.name == dependency; });
+        MANGOS_ASSERT(itr != m_steps.end());                // unknown or later added dependency
+        itr->dependents.push_back(index);
+        ++step.pendingDependencies;
+    }
+
+    m_steps.push_back(step);
+}
+
+void WorldLoader::RunStep(size_t index)
+{
+    Step& step = m_steps[index];
+    sLog.outString("Loading %s...", step.name.c_str());
+
+    uint32 start = WorldTimer::getMSTime();
+    step.function();
+    step.startTime = WorldTimer::getMSTimeDiff(m_startTime, start);
+    step.duration = WorldTimer::getMSTimeDiff(start, WorldTimer::getMSTime());
+}
+
+void WorldLoader::RunWorker(bool ownThread)
+{
+    if (ownThread)
+        WorldDatabase.ThreadStart();                        // let thread do safe mySQL requests
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (m_finished < m_steps.size())
+    {
+        if (m_ready.empty())
+        {
+            m_stepDone.wait(guard);
+            continue;
+        }
+
+        size_t index = m_ready.front();
+        m_ready.erase(m_ready.begin());
+
+        guard.unlock();
+        RunStep(index);
+        guard.lock();
+
+        ++m_finished;
+        for (size_t dependent : m_steps[index].dependents)
+        {
+            if (--m_steps[dependent].pendingDependencies == 0)
+                m_ready.insert(std::lower_bound(m_ready.begin(), m_ready.end(), dependent), dependent);
+        }
+
+        m_stepDone.notify_all();
+    }
+
+    guard.unlock();
+
+    if (ownThread)
+        WorldDatabase.ThreadEnd();                          // free mySQL thread resources
+}
+
+void WorldLoader::Run(uint32 threads)
+{
+    m_startTime = WorldTimer::getMSTime();
+
+    if (!threads)
+    {
+        for (size_t i = 0; i < m_steps.size(); ++i)
+            RunStep(i);
+    }
+    else
+    {
+        m_finished = 0;
+        m_ready.clear();
+        for (size_t i = 0; i < m_steps.size(); ++i)
+            if (!m_steps[i].pendingDependencies)
+                m_ready.push_back(i);
+
+        // progress bars of concurrent steps would overwrite each other
+        bool showProgress = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        // the calling thread is one of the loaders
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < threads; ++i)
+            workers.emplace_back(&WorldLoader::RunWorker, this, true);
+
+        RunWorker(false);
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        BarGoLink::SetOutputState(showProgress);
+    }
+
+    m_totalTime = WorldTimer::getMSTimeDiff(m_startTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::PrintTimings(uint32 count) const
+{
+    std::vector<Step const*> steps;
+    uint32 sequentialTime = 0;
+    for (Step const& step : m_steps)
+    {
+        steps.push_back(&step);
+        sequentialTime += step.duration;
+    }
+
+    std::sort(steps.begin(), steps.end(), [](Step const* a, Step const* b) { return a->duration > b->duration; });
+
+    sLog.outString("Startup load of %u steps took %u ms (%u ms in sum of steps), slowest steps:", uint32(m_steps.size()), m_totalTime, sequentialTime);
+    for (uint32 i = 0; i < steps.size() && i < count; ++i)
+        sLog.outString("    %-50s %6u ms (started at %u ms)", steps[i]->name.c_str(), steps[i]->duration, steps[i]->startTime);
+    sLog.outString();
+}
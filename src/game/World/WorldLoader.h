@@ -0,0 +1,77 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _WORLD_LOADER_H_INCLUDED
+#define _WORLD_LOADER_H_INCLUDED
+
+#include "Common.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Runs the steps of the world startup as a dependency graph.
+ *
+ * Every step names the steps it needs to be finished before it starts. Without
+ * load threads the steps run in the order they were added, else each step starts
+ * as soon as its dependencies are done, so independent tables load concurrently.
+ * A step must list every step whose data it reads or writes, the loaders are not
+ * synchronized otherwise.
+ */
+class WorldLoader
+{
+    public:
+        typedef std::function<void()> LoadFunction;
+
+        // dependencies must have been added before, steps are named by their log text
+        void AddStep(char const* name, LoadFunction function, std::vector<char const*> const& dependencies = std::vector<char const*>());
+
+        void Run(uint32 threads);
+
+        // logs the slowest steps and the gain of the concurrent load
+        void PrintTimings(uint32 count) const;
+
+    private:
+        struct Step
+        {
+            std::string name;
+            LoadFunction function;
+            std::vector<size_t> dependents;
+            uint32 pendingDependencies;
+            uint32 startTime;                               // ms since Run
+            uint32 duration;                                // ms
+        };
+
+        void RunStep(size_t index);
+        void RunWorker(bool ownThread);                     // ownThread: started by Run, not the calling thread
+
+        std::vector<Step> m_steps;
+        uint32 m_totalTime;
+
+        // state of a concurrent run
+        std::mutex m_lock;
+        std::condition_variable m_stepDone;
+        std::vector<size_t> m_ready;                        // in adding order, the first added ready step runs first
+        size_t m_finished;
+        uint32 m_startTime;
+};
+
+#endif
@@ -221,7 +221,7 @@ int Master::Run()
             sLog.outError("Invalid network tread workers setting in mangosd.conf. (%d) should be > 0", networkThreadWorker);
             networkThreadWorker = 1;
         }
-        MaNGOS::Listener<WorldSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)), networkThreadWorker);
+        MaNGOS::Listener<WorldSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)), networkThreadWorker, sConfig.GetBoolDefault("Network.ReusePort", false));
 
         std::unique_ptr<MaNGOS::Listener<RASocket>> raListener;
         if (sConfig.GetBoolDefault("Ra.Enable", false))
@@ -350,6 +350,9 @@ bool Master::_StartDB()
         return false;
     }
 
+    WorldDatabase.SetSnapshotDirectory(sConfig.GetStringDefault("WorldDatabaseSnapshotDir", ""));
+    WorldDatabase.SetBinaryResults(sConfig.GetBoolDefault("DatabaseBinaryResults", false));
+
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
     if (dbstring.empty())
@@ -360,10 +363,13 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    int nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
+    if (nAsyncConnections < 1)
+        nAsyncConnections = 1;
+    sLog.outString("Character Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -388,6 +394,8 @@ bool Master::_StartDB()
         return false;
     }
 #endif
+    CharacterDatabase.SetBinaryResults(sConfig.GetBoolDefault("DatabaseBinaryResults", false));
+
     ///- Get login database info from configuration file
     dbstring = sConfig.GetStringDefault("LoginDatabaseInfo");
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
@@ -246,11 +246,37 @@ bool AuthSocket::ProcessIncomingData()
         }
 
         // if we reach here, it means that a valid opcode was found and the handler completed successfully
+
+        // the handler waits for the database, remaining data is handled after it continued
+        if (IsReadSuspended())
+            break;
     }
 
     return true;
 }
 
+bool AuthSocket::AsyncQuery(QueryHandler handler, const char* format, ...)
+{
+    // the login database is not queried on the network thread, handling of further data waits for the result
+    SuspendRead();
+
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    va_list ap;
+    va_start(ap, format);
+    bool queued = LoginDatabase.AsyncVPQuery([self, handler](QueryResult* result)
+    {
+        std::shared_ptr<QueryResult> resultHolder(result);
+        self->ResumeRead([self, handler, resultHolder]() { return (self.get()->*handler)(resultHolder.get()); });
+    }, format, ap);
+    va_end(ap);
+
+    // nothing would ever resume reading, do not leave the client hanging
+    if (!queued)
+        Close();
+
+    return queued;
+}
+
 void AuthSocket::SendProof(Sha1Hash sha)
 {
     switch (_build)
@@ -334,8 +360,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -356,142 +380,151 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
-    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
-    pkt << (uint8) 0x00;
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4 - i - 1];
 
     ///- Verify that this IP is not in the ip_banned table
     // No SQL injection possible (paste the IP address as passed by the socket)
-    std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-            "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str()));
+    return AsyncQuery(&AuthSocket::_OnLogonChallengeIpBan, "SELECT expires_at FROM ip_banned "
+                      "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
+}
 
-    if (ip_banned_result)
+bool AuthSocket::_OnLogonChallengeIpBan(QueryResult* result)
+{
+    if (result)
     {
+        ByteBuffer pkt;
+        pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+        pkt << (uint8) 0x00;
         pkt << (uint8)WOW_FAIL_FAIL_NOACCESS;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
+
+        Write((const char*)pkt.contents(), pkt.size());
+        return true;
     }
-    else
+
+    ///- Get the account details from the account table, with its active ban if any
+    // No SQL injection (escaped user name)
+    return AsyncQuery(&AuthSocket::_OnLogonChallengeAccount, "SELECT a.id,a.locked,a.last_ip,a.gmlevel,a.v,a.s,a.token,ab.banned_at,ab.expires_at FROM account a "
+                      "LEFT JOIN account_banned ab ON ab.account_id = a.id AND ab.active = 1 AND (ab.expires_at > UNIX_TIMESTAMP() OR ab.expires_at = ab.banned_at) "
+                      "WHERE a.username = '%s'", _safelogin.c_str());
+}
+
+bool AuthSocket::_OnLogonChallengeAccount(QueryResult* result)
+{
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+
+    if (result)
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,last_ip,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
-        if (result)
+        Field* fields = result->Fetch();
+
+        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+        bool locked = false;
+        if (fields[1].GetUInt8() == 1)                   // if ip is locked
+        {
+            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[2].GetString());
+            DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
+            if (strcmp(fields[2].GetString(), m_address.c_str()))
+            {
+                DEBUG_LOG("[AuthChallenge] Account IP differs");
+                pkt << (uint8) WOW_FAIL_SUSPENDED;
+                locked = true;
+            }
+            else
+                DEBUG_LOG("[AuthChallenge] Account IP matches");
+        }
+        else
+            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+
+        std::string databaseV = fields[4].GetCppString();
+        std::string databaseS = fields[5].GetCppString();
+        bool broken = false;
+
+        if (!srp.SetVerifier(databaseV.c_str()) || !srp.SetSalt(databaseS.c_str()))
         {
-            Field* fields = result->Fetch();
+            pkt << (uint8)WOW_FAIL_FAIL_NOACCESS;
+            DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", _login.c_str());
+            broken = true;
+        }
 
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if (fields[1].GetUInt8() == 1)               // if ip is locked
+        if (!locked && !broken)
+        {
+            ///- If the account is banned, reject the logon attempt
+            if (!fields[7].IsNULL())
             {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[2].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
-                if (strcmp(fields[2].GetString(), m_address.c_str()))
+                if (fields[7].GetUInt64() == fields[8].GetUInt64())
                 {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-                    pkt << (uint8) WOW_FAIL_SUSPENDED;
-                    locked = true;
+                    pkt << (uint8) WOW_FAIL_BANNED;
+                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
                 }
                 else
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
+                {
+                    pkt << (uint8) WOW_FAIL_SUSPENDED;
+                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
+                }
             }
             else
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+            {
+                DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-            std::string databaseV = fields[4].GetCppString();
-            std::string databaseS = fields[5].GetCppString();
-            bool broken = false;
+                BigNumber s;
+                s.SetHexStr(databaseS.c_str());
 
-            if (!srp.SetVerifier(databaseV.c_str()) || !srp.SetSalt(databaseS.c_str()))
-            {
-                pkt << (uint8)WOW_FAIL_FAIL_NOACCESS;
-                DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", _login.c_str());
-                broken = true;
-            }
+                srp.CalculateHostPublicEphemeral();
 
-            if (!locked && !broken)
-            {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                                         "account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", fields[1].GetUInt32());
-                if (banresult)
+                ///- Fill the response packet with the result
+                pkt << uint8(WOW_SUCCESS);
+
+                // B may be calculated < 32B so we force minimal length to 32B
+                pkt.append(srp.GetHostPublicEphemeral().AsByteArray(32), 32);      // 32 bytes
+                pkt << uint8(1);
+                pkt.append(srp.GetGeneratorModulo().AsByteArray(), 1);
+                pkt << uint8(32);
+                pkt.append(srp.GetPrime().AsByteArray(32), 32);
+                pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
+                pkt.append(VersionChallenge.data(), VersionChallenge.size());
+                uint8 securityFlags = 0;
+
+                _token = fields[6].GetCppString();
+                if (!_token.empty() && _build >= 8606) // authenticator was added in 2.4.3
+                    securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+
+                pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+
+                if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
                 {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << (uint8) WOW_FAIL_BANNED;
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
-                    }
-                    else
-                    {
-                        pkt << (uint8) WOW_FAIL_SUSPENDED;
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
-                    }
-
-                    delete banresult;
+                    pkt << uint32(0);
+                    pkt << uint64(0);
+                    pkt << uint64(0);
                 }
-                else
+
+                if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
                 {
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint64(0);
+                }
 
-                    BigNumber s;
-                    s.SetHexStr(databaseS.c_str());
+                if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
+                    pkt << uint8(1);
 
-                    srp.CalculateHostPublicEphemeral();
+                uint8 secLevel = fields[3].GetUInt8();
+                _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
+                BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(srp.GetHostPublicEphemeral().AsByteArray(32), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(srp.GetGeneratorModulo().AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(srp.GetPrime().AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(VersionChallenge.data(), VersionChallenge.size());
-                    uint8 securityFlags = 0;
-
-                    _token = fields[6].GetCppString();
-                    if (!_token.empty() && _build >= 8606) // authenticator was added in 2.4.3
-                        securityFlags = SECURITY_FLAG_AUTHENTICATOR;
-
-                    pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
-
-                    if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                        pkt << uint8(1);
-
-                    uint8 secLevel = fields[3].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4 - i - 1];
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
-
-                    ///- All good, await client's proof
-                    _status = STATUS_LOGON_PROOF;
-                }
+                ///- All good, await client's proof
+                _status = STATUS_LOGON_PROOF;
             }
-            delete result;
         }
-        else                                                // no account
-            pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
     }
+    else                                                    // no account
+        pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
 
     Write((const char*)pkt.contents(), pkt.size());
     return true;
@@ -602,37 +635,43 @@ bool AuthSocket::_HandleLogonProof()
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+            return AsyncQuery(&AuthSocket::_OnLogonProofFailedLogins, "SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
+        }
+    }
+    return true;
+}
 
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
-                                               "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+bool AuthSocket::_OnLogonProofFailedLogins(QueryResult* result)
+{
+    if (!result)
+        return true;
+
+    Field* fields = result->Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
+    if (failed_logins >= MaxWrongPassCount)
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if (WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
+                                   "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                   acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                      _login.c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = m_address;
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                   current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                      current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
         }
     }
     return true;
@@ -681,19 +720,20 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    return AsyncQuery(&AuthSocket::_OnReconnectChallengeAccount, "SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+}
 
+bool AuthSocket::_OnReconnectChallengeAccount(QueryResult* result)
+{
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
-        Close();
         return false;
     }
 
     Field* fields = result->Fetch();
     srp.SetStrongSessionKey(fields[0].GetString());
-    delete result;
 
     ///- All good, await client's proof
     _status = STATUS_RECON_PROOF;
@@ -770,26 +810,35 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
+    ///- Get the user id (else close the connection) and the amount of characters on each realm
     // No SQL injection (escaped user name)
+    return AsyncQuery(&AuthSocket::_OnRealmListAccount, "SELECT a.id,rc.realmid,rc.numchars FROM account a "
+                      "LEFT JOIN realmcharacters rc ON rc.acctid = a.id WHERE a.username = '%s'", _safelogin.c_str());
+}
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str());
+bool AuthSocket::_OnRealmListAccount(QueryResult* result)
+{
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
-        Close();
         return false;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    delete result;
+    std::map<uint32, uint8> characterCounts;
+    do
+    {
+        Field* fields = result->Fetch();
+        if (!fields[1].IsNULL())
+            characterCounts[fields[1].GetUInt32()] = fields[2].GetUInt8();
+    }
+    while (result->NextRow());
 
     ///- Update realm list if need
     sRealmList.UpdateIfNeed();
 
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt, characterCounts);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -800,7 +849,7 @@ bool AuthSocket::_HandleRealmList()
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts)
 {
     switch (_build)
     {
@@ -813,18 +862,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto characterCount = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = characterCount != characterCounts.end() ? characterCount->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -874,18 +913,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto characterCount = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = characterCount != characterCounts.end() ? characterCount->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -34,6 +34,9 @@
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <map>
+
+class QueryResult;
 
 #define HMAC_RES_SIZE 20
 
@@ -45,7 +48,7 @@ class AuthSocket : public MaNGOS::Socket
         AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler);
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        void LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts);
         int32 generateToken(char const* b32key);
 
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
@@ -71,6 +74,17 @@ class AuthSocket : public MaNGOS::Socket
             STATUS_CLOSED
         };
 
+        typedef bool (AuthSocket::*QueryHandler)(QueryResult* result);
+
+        // handlers needing the database suspend reading, handler continues on the network thread with the result
+        bool AsyncQuery(QueryHandler handler, const char* format, ...) ATTR_PRINTF(3, 4);
+
+        bool _OnLogonChallengeIpBan(QueryResult* result);
+        bool _OnLogonChallengeAccount(QueryResult* result);
+        bool _OnLogonProofFailedLogins(QueryResult* result);
+        bool _OnReconnectChallengeAccount(QueryResult* result);
+        bool _OnRealmListAccount(QueryResult* result);
+
         SRP6 srp;
         BigNumber _reconnectProof;
 
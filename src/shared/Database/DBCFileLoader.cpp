@@ -22,68 +22,81 @@
 
 #include "DBCFileLoader.h"
 
+#define DBC_HEADER_SIZE 20
+
 DBCFileLoader::DBCFileLoader()
 {
     data = nullptr;
     fieldsOffset = nullptr;
 }
 
-bool DBCFileLoader::Load(const char* filename, const char* fmt)
+bool DBCFileLoader::Load(const char* filename, const char* fmt, bool mapped)
 {
-    uint32 header;
-    delete[] data;
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
+    if (!m_file)
+        delete[] data;
+    data = nullptr;
+    m_file.reset();
 
-    if (fread(&header, 4, 1, f) != 1)                       // Number of records
+    if (mapped)
     {
-        fclose(f);
-        return false;
-    }
-
+        // copy on write, some entries get patched after loading
+        std::unique_ptr<MappedFile> file(new MappedFile);
+        if (file->Open(filename, true))
+        {
+            if (file->GetSize() < DBC_HEADER_SIZE || !ReadHeader(file->GetData(), fmt))
+                return false;
 
-    EndianConvert(header);
+            if (file->GetSize() < DBC_HEADER_SIZE + size_t(recordSize) * recordCount + stringSize)
+                return false;
 
-    if (header != 0x43424457)                               //'WDBC'
-    {
-        fclose(f);
-        return false;
+            data = file->GetWritableData() + DBC_HEADER_SIZE;
+            stringTable = data + recordSize * recordCount;
+            m_file = std::move(file);
+            return true;
+        }
+        // not mappable, read it instead
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                  // Number of records
-    {
-        fclose(f);
+    FILE* f = fopen(filename, "rb");
+    if (!f)
         return false;
-    }
-
-    EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                   // Number of fields
+    unsigned char header[DBC_HEADER_SIZE];
+    if (fread(header, DBC_HEADER_SIZE, 1, f) != 1 || !ReadHeader(header, fmt))
     {
         fclose(f);
         return false;
     }
 
-    EndianConvert(fieldCount);
+    data = new unsigned char[recordSize * recordCount + stringSize];
+    stringTable = data + recordSize * recordCount;
 
-    if (fread(&recordSize, 4, 1, f) != 1)                   // Size of a record
+    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
     {
         fclose(f);
         return false;
     }
 
-    EndianConvert(recordSize);
+    fclose(f);
+    return true;
+}
 
-    if (fread(&stringSize, 4, 1, f) != 1)                   // String size
-    {
-        fclose(f);
+bool DBCFileLoader::ReadHeader(unsigned char const* header, const char* fmt)
+{
+    uint32 values[DBC_HEADER_SIZE / 4];
+    memcpy(values, header, sizeof(values));
+    for (uint32& value : values)
+        EndianConvert(value);
+
+    if (values[0] != 0x43424457)                            //'WDBC'
         return false;
-    }
 
-    EndianConvert(stringSize);
+    recordCount = values[1];                                // Number of records
+    fieldCount = values[2];                                 // Number of fields
+    recordSize = values[3];                                 // Size of a record
+    stringSize = values[4];                                 // String size
 
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -95,22 +108,13 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize * recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+    if (!m_file)
+        delete[] data;
     delete[] fieldsOffset;
 }
 
@@ -165,34 +169,35 @@ uint32 DBCFileLoader::GetFormatRecordSize(const char* format, int32* index_pos)
     return recordsize;
 }
 
-char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable)
+bool DBCFileLoader::IsUsableInPlace(const char* format) const
 {
-    /*
-    format STRING, NA, FLOAT,NA,INT <=>
-    struct{
-    char* field0,
-    float field1,
-    int field2
-    }entry;
+    // records would need byte swapping
+    if (!m_file || MANGOS_ENDIAN == MANGOS_BIGENDIAN)
+        return false;
 
-    this func will generate  entry[rows] data;
-    */
+    if (strlen(format) != fieldCount || recordSize != fieldCount * 4)
+        return false;
 
-    typedef char* ptr;
-    if (strlen(format) != fieldCount)
-        return nullptr;
+    // every field is in the structure as it is in the file
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_IND && format[x] != FT_INT && format[x] != FT_FLOAT)
+            return false;
 
-    // get struct size and index pos
-    int32 i;
-    uint32 recordsize = GetFormatRecordSize(format, &i);
+    return true;
+}
 
-    if (i >= 0)
+char** DBCFileLoader::CreateIndexTable(int32 indexField, uint32& records)
+{
+    typedef char* ptr;
+    ptr* indexTable;
+
+    if (indexField >= 0)
     {
         uint32 maxi = 0;
         // find max index
         for (uint32 y = 0; y < recordCount; ++y)
         {
-            uint32 ind = getRecord(y).getUInt(i);
+            uint32 ind = getRecord(y).getUInt(indexField);
             if (ind > maxi)
                 maxi = ind;
         }
@@ -208,6 +213,53 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    return indexTable;
+}
+
+char** DBCFileLoader::AutoProduceIndex(const char* format, uint32& records)
+{
+    if (!IsUsableInPlace(format))
+        return nullptr;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    char** indexTable = CreateIndexTable(i, records);
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = record;
+        else
+            indexTable[y] = record;
+    }
+
+    return indexTable;
+}
+
+char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable)
+{
+    /*
+    format STRING, NA, FLOAT,NA,INT <=>
+    struct{
+    char* field0,
+    float field1,
+    int field2
+    }entry;
+
+    this func will generate  entry[rows] data;
+    */
+
+    if (strlen(format) != fieldCount)
+        return nullptr;
+
+    // get struct size and index pos
+    int32 i;
+    uint32 recordsize = GetFormatRecordSize(format, &i);
+
+    indexTable = CreateIndexTable(i, records);
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -264,8 +316,14 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return nullptr;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool;
+    if (m_file)
+        stringPool = reinterpret_cast<char*>(stringTable);
+    else
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool, stringTable, stringSize);
+    }
 
     uint32 offset = 0;
 
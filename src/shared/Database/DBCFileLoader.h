@@ -20,7 +20,9 @@
 #define DBC_FILE_LOADER_H
 #include "Platform/Define.h"
 #include "Utilities/ByteConverter.h"
+#include "MappedFile.h"
 #include <cassert>
+#include <memory>
 
 enum FieldFormat
 {
@@ -44,7 +46,8 @@ class DBCFileLoader
         DBCFileLoader();
         ~DBCFileLoader();
 
-        bool Load(const char* filename, const char* fmt);
+        // mapped files are not copied to memory, see IsUsableInPlace and ReleaseFile
+        bool Load(const char* filename, const char* fmt, bool mapped = false);
 
         class Record
         {
@@ -93,10 +96,20 @@ class DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        bool IsMapped() const { return m_file != nullptr; }
+        // records of a mapped file with only 4 byte fields can be used as the data table directly
+        bool IsUsableInPlace(const char* format) const;
         char* AutoProduceData(const char* format, uint32& records, char**& indexTable);
+        char** AutoProduceIndex(const char* format, uint32& records);
+        // for a mapped file the strings are not copied, the returned pool is part of the file
         char* AutoProduceStrings(const char* format, char* dataTable);
+        // the mapping that holds data returned by AutoProduceIndex and AutoProduceStrings
+        MappedFile* ReleaseFile() { return m_file.release(); }
         static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
     private:
+        bool ReadHeader(unsigned char const* header, const char* fmt);
+        char** CreateIndexTable(int32 indexField, uint32& records);
+
 
         uint32 recordSize;
         uint32 recordCount;
@@ -105,5 +118,6 @@ class DBCFileLoader
         uint32* fieldsOffset;
         unsigned char* data;
         unsigned char* stringTable;
+        std::unique_ptr<MappedFile> m_file;
 };
 #endif
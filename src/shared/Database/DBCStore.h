@@ -21,10 +21,13 @@
 
 #include "DBCFileLoader.h"
 
+#include <cstring>
+
 template<class T>
 class DBCStorage
 {
         typedef std::list<char*> StringPoolList;
+        typedef std::list<MappedFile*> MappedFileList;
     public:
         explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
         ~DBCStorage() { Clear(); }
@@ -34,26 +37,34 @@ class DBCStorage
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
 
-        bool Load(char const* fn)
+        bool Load(char const* fn, bool mapped = false)
         {
             DBCFileLoader dbc;
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc.Load(fn, fmt, mapped))
                 return false;
 
             fieldCount = dbc.GetCols();
 
+            // records without strings and skipped fields are used from the mapped file as they are
+            if (dbc.IsUsableInPlace(fmt))
+            {
+                indexTable = (T**)dbc.AutoProduceIndex(fmt, nCount);
+                m_fileList.push_back(dbc.ReleaseFile());
+                return indexTable != nullptr;
+            }
+
             // load raw non-string data
             m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
 
             // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            AddStringPool(dbc, dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
 
             // error in dbc file at loading if nullptr
             return indexTable != nullptr;
         }
 
-        bool LoadStringsFrom(char const* fn)
+        bool LoadStringsFrom(char const* fn, bool mapped = false)
         {
             // DBC must be already loaded using Load
             if (!indexTable)
@@ -61,11 +72,11 @@ class DBCStorage
 
             DBCFileLoader dbc;
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc.Load(fn, fmt, mapped))
                 return false;
 
             // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            AddStringPool(dbc, dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
 
             return true;
         }
@@ -85,6 +96,12 @@ class DBCStorage
                 delete[] m_stringPoolList.front();
                 m_stringPoolList.pop_front();
             }
+
+            while (!m_fileList.empty())
+            {
+                delete m_fileList.front();
+                m_fileList.pop_front();
+            }
             nCount = 0;
         }
 
@@ -92,12 +109,22 @@ class DBCStorage
         void InsertEntry(T* entry, uint32 id) { assert(id < nCount && "To be inserted entry must be in bounds!"); indexTable[id] = entry; }
 
     private:
+        void AddStringPool(DBCFileLoader& dbc, char* stringPool)
+        {
+            // strings of a mapped file point into the mapping, it is shared by all processes using the file
+            if (!dbc.IsMapped())
+                m_stringPoolList.push_back(stringPool);
+            else if (strchr(fmt, FT_STRING))
+                m_fileList.push_back(dbc.ReleaseFile());
+        }
+
         uint32 nCount;
         uint32 fieldCount;
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
         StringPoolList m_stringPoolList;
+        MappedFileList m_fileList;
 };
 
 #endif
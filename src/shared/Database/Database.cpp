@@ -19,12 +19,14 @@
 #include "DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Database/SqlOperations.h"
+#include "Database/QueryResultSnapshot.h"
 
 #include <ctime>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <cstdarg>
+#include <algorithm>
 
 #define MIN_CONNECTION_POOL_SIZE 1
 #define MAX_CONNECTION_POOL_SIZE 16
@@ -97,7 +99,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -139,6 +141,20 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     if (!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    // and the ones for keyed transactions
+    nAsyncConns = std::min(nAsyncConns, MAX_CONNECTION_POOL_SIZE);
+    for (int i = 1; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pKeyedAsyncConns.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -159,6 +175,11 @@ void Database::StopServer()
         delete m_pQueryConnection;
 
     m_pQueryConnections.clear();
+
+    for (auto& keyedConn : m_pKeyedAsyncConns)
+        delete keyedConn;
+
+    m_pKeyedAsyncConns.clear();
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -174,6 +195,14 @@ void Database::InitDelayThread()
     // New delay thread for delay execute
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_delayThread = new MaNGOS::Thread(m_threadBody);
+
+    for (auto& keyedConn : m_pKeyedAsyncConns)
+    {
+        SqlDelayThread* threadBody = new SqlDelayThread(this, keyedConn, true);
+        m_keyedThreadBodies.push_back(threadBody);
+        m_keyedDelayThreads.push_back(new MaNGOS::Thread(threadBody));
+        m_threadBody->AddKeyedWorker(threadBody);
+    }
 }
 
 void Database::HaltDelayThread()
@@ -185,6 +214,16 @@ void Database::HaltDelayThread()
     delete m_delayThread;                                   // This also deletes m_threadBody
     m_delayThread = nullptr;
     m_threadBody = nullptr;
+
+    // keyed executers last, the main one may still hand requests to them while stopping
+    for (size_t i = 0; i < m_keyedDelayThreads.size(); ++i)
+    {
+        m_keyedThreadBodies[i]->Stop();
+        m_keyedDelayThreads[i]->wait();
+        delete m_keyedDelayThreads[i];
+    }
+    m_keyedThreadBodies.clear();
+    m_keyedDelayThreads.clear();
 }
 
 void Database::ThreadStart()
@@ -302,6 +341,87 @@ QueryResult* Database::PQuery(const char* format, ...)
     return Query(szQuery);
 }
 
+bool Database::AsyncQuery(std::function<void(QueryResult*)> handler, const char* sql)
+{
+    if (!sql || !m_threadBody)
+        return false;
+
+    return m_threadBody->Delay(new SqlDirectQuery(sql, std::move(handler)));
+}
+
+bool Database::AsyncPQuery(std::function<void(QueryResult*)> handler, const char* format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    bool res = AsyncVPQuery(std::move(handler), format, ap);
+    va_end(ap);
+
+    return res;
+}
+
+bool Database::AsyncVPQuery(std::function<void(QueryResult*)> handler, const char* format, va_list ap)
+{
+    if (!format) return false;
+
+    char szQuery [MAX_QUERY_LEN];
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return false;
+    }
+
+    return AsyncQuery(std::move(handler), szQuery);
+}
+
+QueryResult* Database::QuerySnapshot(const char* name, const char* tables, std::string const& sql)
+{
+    if (m_snapshotDirectory.empty())
+        return Query(sql.c_str());
+
+    // key of the snapshot: query text, DB version and the content of all used tables
+    std::string key = sql;
+    QueryResult* result = Query("SELECT * FROM db_version");
+    if (result)
+    {
+        for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+            key.append("|").append((*result)[i].GetString());
+        delete result;
+    }
+
+    result = PQuery("CHECKSUM TABLE %s", tables);
+    if (!result)                                            // not supported by the DBMS
+        return Query(sql.c_str());
+
+    do
+    {
+        Field* fields = result->Fetch();
+        if (fields[1].IsNULL())                             // table does not exist
+        {
+            delete result;
+            return Query(sql.c_str());
+        }
+        key.append("|").append(fields[0].GetString()).append("=").append(fields[1].GetString());
+    }
+    while (result->NextRow());
+    delete result;
+
+    uint64 hash = 14695981039346656037ULL;                  // FNV-1a
+    for (char c : key)
+    {
+        hash ^= uint8(c);
+        hash *= 1099511628211ULL;
+    }
+
+    std::string fileName = m_snapshotDirectory + "/" + name + ".snapshot";
+    if (QueryResultSnapshot::Open(fileName, hash, result))
+        return result;
+
+    sLog.outString("Creating query snapshot %s...", fileName.c_str());
+    return QueryResultSnapshot::Create(fileName, hash, Query(sql.c_str()));
+}
+
 QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 {
     if (!format) return nullptr;
@@ -385,7 +505,7 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 serialKey)
 {
     if (!m_pAsyncConn)
         return false;
@@ -393,7 +513,7 @@ bool Database::BeginTransaction()
     MANGOS_ASSERT(!m_currentTransaction.get());   // if we will get a nested transaction request - we MUST fix code!!!
 
     if (!m_currentTransaction.get())
-        m_currentTransaction.reset(new SqlTransaction);
+        m_currentTransaction.reset(new SqlTransaction(serialKey));
 
     return m_currentTransaction.get() != nullptr;
 }
@@ -27,6 +27,7 @@
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
+#include <cstdarg>
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -104,7 +105,8 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        // nAsyncConns > 1 adds connections for transactions started with a serial key, see BeginTransaction()
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
         // start worker thread for async DB request execution
         virtual void InitDelayThread();
         // stop worker thread
@@ -126,6 +128,17 @@ class Database
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        // Query() for static data: rows are read from the snapshot file 'name' while db_version and the
+        // checksums of the (comma separated) tables are unchanged, else it is recreated from the query
+        QueryResult* QuerySnapshot(const char* name, const char* tables, std::string const& sql);
+        // empty disables snapshots
+        void SetSnapshotDirectory(std::string const& directory) { m_snapshotDirectory = directory; }
+
+        // Query() reads select results in the binary protocol of server side prepared statements where the
+        // DBMS supports it: numbers are not converted to text and back, but each query needs an extra round trip
+        void SetBinaryResults(bool enable) { m_binaryResults = enable; }
+        bool IsBinaryResults() const { return m_binaryResults; }
+
         bool DirectExecute(const char* sql) const
         {
             if (!m_pAsyncConn)
@@ -171,6 +184,11 @@ class Database
         bool AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...) ATTR_PRINTF(5, 6);
         template<typename ParamType1, typename ParamType2, typename ParamType3>
         bool AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* format, ...) ATTR_PRINTF(6, 7);
+        // Query / function, called by the delay thread itself with the result it has to take over
+        bool AsyncQuery(std::function<void(QueryResult*)> handler, const char* sql);
+        // PQuery / function
+        bool AsyncPQuery(std::function<void(QueryResult*)> handler, const char* format, ...) ATTR_PRINTF(3, 4);
+        bool AsyncVPQuery(std::function<void(QueryResult*)> handler, const char* format, va_list ap);
         template<class Class>
         // QueryHolder
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
@@ -183,7 +201,9 @@ class Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
+        // async transactions with a non zero serialKey (e.g. a character guid) may run in parallel
+        // with the ones of other keys, they stay ordered to requests with the same key or without one
+        bool BeginTransaction(uint32 serialKey = 0);
         bool CommitTransaction();
         bool RollbackTransaction();
         // for sync transaction execution
@@ -224,7 +244,7 @@ class Database
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
             m_threadBody(nullptr), m_delayThread(nullptr), m_bAllowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_iStmtIndex(-1), m_binaryResults(false), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
         }
@@ -252,6 +272,8 @@ class Database
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
 
+        std::string m_snapshotDirectory;
+
         // connection helper counters
         int m_nQueryConnPoolSize;                           // current size of query connection pool
         std::atomic_long m_nQueryCounter;  // counter for connection selection
@@ -267,6 +289,11 @@ class Database
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
 
+        // additional connections and executers for keyed transactions, fed by m_threadBody
+        SqlConnectionContainer m_pKeyedAsyncConns;
+        std::vector<SqlDelayThread*> m_keyedThreadBodies;
+        std::vector<MaNGOS::Thread*> m_keyedDelayThreads;
+
         bool m_bAllowAsyncTransactions;                     ///< flag which specifies if async transactions are enabled
 
         // PREPARED STATEMENT REGISTRY
@@ -280,6 +307,8 @@ class Database
 
         int m_iStmtIndex;
 
+        bool m_binaryResults;
+
     private:
 
         bool m_logSQL;
@@ -204,8 +204,78 @@ bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD**
     return true;
 }
 
+bool MySQLConnection::_QueryBinary(const char* sql, QueryResult** pResult)
+{
+    *pResult = nullptr;
+
+    if (!mMysql || strnicmp(sql, "select", 6) != 0)
+        return false;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+        return false;
+
+    MYSQL_RES* metadata = nullptr;
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) || mysql_stmt_param_count(stmt) || !(metadata = mysql_stmt_result_metadata(stmt)))
+    {
+        mysql_stmt_close(stmt);
+        return false;
+    }
+
+    // let the stored result report the longest values to size the string buffers
+    bool updateMaxLength = true;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    if (mysql_stmt_execute(stmt) || mysql_stmt_store_result(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return true;
+    }
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    uint64 rowCount = mysql_stmt_num_rows(stmt);
+    if (!rowCount)
+    {
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return true;
+    }
+
+    // the rows are copied and the statement closed here, the caller holds the connection lock only until we return
+    QueryResultMysqlBinary* queryResult = new QueryResultMysqlBinary(rowCount, mysql_num_fields(metadata));
+    if (!queryResult->FetchRows(stmt, metadata))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        delete queryResult;
+        queryResult = nullptr;
+    }
+
+    mysql_free_result(metadata);
+    mysql_stmt_close(stmt);
+
+    if (!queryResult)
+        return true;
+
+    queryResult->NextRow();
+    *pResult = queryResult;
+    return true;
+}
+
 QueryResult* MySQLConnection::Query(const char* sql)
 {
+    if (DB().IsBinaryResults())
+    {
+        QueryResult* queryResult;
+        if (_QueryBinary(sql, &queryResult))
+            return queryResult;
+    }
+
     MYSQL_RES* result = nullptr;
     MYSQL_FIELD* fields = nullptr;
     uint64 rowCount = 0;
@@ -416,7 +486,7 @@ void MySqlPreparedStatement::addParam(unsigned int nIndex, const SqlStmtFieldDat
 
     MYSQL_BIND& pData = m_pInputArgs[nIndex];
 
-    my_bool bUnsigned = 0;
+    bool bUnsigned = false;
     enum_field_types dataType = ToMySQLType(data, bUnsigned);
 
     // setup MYSQL_BIND structure
@@ -461,9 +531,9 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
-enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, my_bool& bUnsigned)
+enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned)
 {
-    bUnsigned = 0;
+    bUnsigned = false;
     enum_field_types dataType = MYSQL_TYPE_NULL;
 
     switch (data.type())
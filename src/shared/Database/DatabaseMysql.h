@@ -47,7 +47,7 @@ class MySqlPreparedStatement : public SqlPreparedStatement
         // bind parameters
         void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
 
-        static enum_field_types ToMySQLType(const SqlStmtFieldData& data, my_bool& bUnsigned);
+        static enum_field_types ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned);
 
     private:
         void RemoveBinds();
@@ -85,6 +85,8 @@ class MySQLConnection : public SqlConnection
     private:
         bool _TransactionCmd(const char* sql);
         bool _Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount);
+        // false if the query can't be prepared and has to be sent as text
+        bool _QueryBinary(const char* sql, QueryResult** pResult);
 
         MYSQL* mMysql;
 };
@@ -17,4 +17,16 @@
  */
 
 //#include "DatabaseEnv.h"
+#include "Field.h"
+
+void Field::FormatBinaryValue() const
+{
+    // enough digits to read back the same value
+    if (mType == DB_TYPE_FLOAT)
+        snprintf(mText, sizeof(mText), "%.17g", mNumber.d);
+    else if (mUnsigned)
+        snprintf(mText, sizeof(mText), UI64FMTD, uint64(mNumber.i));
+    else
+        snprintf(mText, sizeof(mText), SI64FMTD, mNumber.i);
+}
 
@@ -34,8 +34,8 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mBinary(false), mUnsigned(false) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mBinary(false), mUnsigned(false) {}
 
         ~Field() {}
 
@@ -44,21 +44,31 @@ class Field
 
         const char* GetString() const
         {
+            if (mBinary && !*mValue)
+                FormatBinaryValue();
             return mValue ? mValue : ""; // We need this null check as we do not always null check what we get back from the database everywhere
         }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            return GetString();                             // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
+        float GetFloat() const
+        {
+            if (mBinary)
+                return mType == DB_TYPE_FLOAT ? static_cast<float>(mNumber.d) : static_cast<float>(mNumber.i);
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const { return mBinary ? GetBinaryInteger() > 0 : (mValue ? atoi(mValue) > 0 : false); }
+        int32 GetInt32() const { return mBinary ? static_cast<int32>(GetBinaryInteger()) : (mValue ? static_cast<int32>(atol(mValue)) : int32(0)); }
+        uint8 GetUInt8() const { return mBinary ? static_cast<uint8>(GetBinaryInteger()) : (mValue ? static_cast<uint8>(atol(mValue)) : uint8(0)); }
+        uint16 GetUInt16() const { return mBinary ? static_cast<uint16>(GetBinaryInteger()) : (mValue ? static_cast<uint16>(atol(mValue)) : uint16(0)); }
+        int16 GetInt16() const { return mBinary ? static_cast<int16>(GetBinaryInteger()) : (mValue ? static_cast<int16>(atol(mValue)) : int16(0)); }
+        uint32 GetUInt32() const { return mBinary ? static_cast<uint32>(GetBinaryInteger()) : (mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0)); }
         uint64 GetUInt64() const
         {
+            if (mBinary)
+                return static_cast<uint64>(GetBinaryInteger());
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -69,13 +79,28 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mBinary = false; }
+        // numbers of binary protocol results, no parsing at reading them and the text is only made for GetString
+        void SetValue(int64 value, bool isUnsigned) { mNumber.i = value; mUnsigned = isUnsigned; SetBinary(); }
+        void SetValue(double value) { mNumber.d = value; SetBinary(); }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        void SetBinary() { mBinary = true; mText[0] = '\0'; mValue = mText; }
+        int64 GetBinaryInteger() const { return mType == DB_TYPE_FLOAT ? static_cast<int64>(mNumber.d) : mNumber.i; }
+        void FormatBinaryValue() const;
+
         const char* mValue;
         enum DataTypes mType;
+        bool mBinary;
+        bool mUnsigned;
+        union
+        {
+            int64 i;
+            double d;
+        } mNumber;
+        mutable char mText[24];
 };
 #endif
@@ -21,6 +21,8 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 
+#include <type_traits>
+
 QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
     QueryResult(rowCount, fieldCount), mResult(result)
 {
@@ -66,7 +68,141 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+QueryResultMysqlBinary::QueryResultMysqlBinary(uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mTypes(fieldCount), mUnsigned(fieldCount), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+}
+
+QueryResultMysqlBinary::~QueryResultMysqlBinary()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlBinary::FetchRows(MYSQL_STMT* stmt, MYSQL_RES* metadata)
+{
+    // the flag type of the client library, char before MySQL 8 and bool since
+    typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type NullFlag;
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<Cell> cells(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::vector<NullFlag> nulls(mFieldCount);
+    std::vector<std::vector<char> > strings(mFieldCount);
+    memset(binds.data(), 0, sizeof(MYSQL_BIND) * mFieldCount);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        MYSQL_BIND& bind = binds[i];
+        bind.length = &lengths[i];
+        bind.is_null = &nulls[i];
+
+        // the client library converts all integer and floating point columns to the bound type
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+                mCurrentRow[i].SetType(Field::DB_TYPE_INTEGER);
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &cells[i].i;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                mCurrentRow[i].SetType(Field::DB_TYPE_FLOAT);
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &cells[i].d;
+                break;
+            default:
+                // strings, decimals and dates keep their text form, max_length is the longest value of the stored result
+                mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+                strings[i].resize(fields[i].max_length + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = strings[i].data();
+                bind.buffer_length = strings[i].size();
+                break;
+        }
+
+        mTypes[i] = bind.buffer_type;
+        mUnsigned[i] = bind.is_unsigned != 0;
+    }
+
+    if (mysql_stmt_bind_result(stmt, binds.data()))
+        return false;
+
+    mCells.reserve(size_t(mRowCount) * mFieldCount);
+    mNulls.reserve(size_t(mRowCount) * mFieldCount);
+
+    for (;;)
+    {
+        int status = mysql_stmt_fetch(stmt);
+        if (status == MYSQL_NO_DATA)
+            break;
+        if (status != 0 && status != MYSQL_DATA_TRUNCATED)
+            return false;
+
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Cell cell = cells[i];
+            if (mTypes[i] == MYSQL_TYPE_STRING && !nulls[i])
+            {
+                cell.text = mText.size();
+                mText.insert(mText.end(), strings[i].begin(), strings[i].begin() + std::min<size_t>(lengths[i], strings[i].size() - 1));
+                mText.push_back('\0');
+            }
+
+            mCells.push_back(cell);
+            mNulls.push_back(nulls[i] != 0);
+        }
+    }
+
+    // rows fetched now, usually the same as reported by the stored result
+    mRowCount = mCells.size() / std::max<uint32>(mFieldCount, 1);
+    return true;
+}
+
+bool QueryResultMysqlBinary::NextRow()
+{
+    if (!mCurrentRow)
+        return false;
+
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    size_t offset = size_t(mNextRow++) * mFieldCount;
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Field& field = mCurrentRow[i];
+        Cell const& cell = mCells[offset + i];
+
+        if (mNulls[offset + i])
+            field.SetValue(nullptr);
+        else if (mTypes[i] == MYSQL_TYPE_LONGLONG)
+            field.SetValue(int64(cell.i), mUnsigned[i]);
+        else if (mTypes[i] == MYSQL_TYPE_DOUBLE)
+            field.SetValue(cell.d);
+        else
+            field.SetValue(&mText[cell.text]);
+    }
+
+    return true;
+}
+
+void QueryResultMysqlBinary::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+}
+
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
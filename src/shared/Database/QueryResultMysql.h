@@ -38,11 +38,44 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
 };
+
+// Result of a server side prepared statement, numbers arrive in binary form and are not parsed.
+// All rows are copied at creation, so the statement can be closed while the connection is still locked
+class QueryResultMysqlBinary : public QueryResult
+{
+    public:
+        QueryResultMysqlBinary(uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlBinary();
+
+        // copies the stored result of the executed statement, false if it can't be fetched
+        bool FetchRows(MYSQL_STMT* stmt, MYSQL_RES* metadata);
+
+        bool NextRow() override;
+
+    private:
+        union Cell
+        {
+            long long i;
+            double d;
+            size_t text;                                    // offset of the value in mText
+        };
+
+        void EndQuery();
+
+        std::vector<enum_field_types> mTypes;               // bound type of each column
+        std::vector<bool> mUnsigned;
+        std::vector<Cell> mCells;                           // row by row
+        std::vector<bool> mNulls;
+        std::vector<char> mText;                            // null terminated values of the text columns
+        uint64 mNextRow;
+};
 #endif
 #endif
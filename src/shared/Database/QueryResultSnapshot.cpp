@@ -0,0 +1,203 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "QueryResultSnapshot.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    uint32 const SNAPSHOT_MAGIC   = 0x50414E53;             // "SNAP"
+    uint32 const SNAPSHOT_VERSION = 1;
+    uint32 const NULL_FIELD       = 0xFFFFFFFF;
+
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 key;
+        uint64 rowCount;
+        uint64 dataSize;
+        uint64 dataChecksum;
+        uint32 fieldCount;
+        uint32 padding;
+    };
+
+    uint64 DataChecksum(char const* data, size_t size)
+    {
+        // FNV-1a
+        uint64 hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= uint8(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+QueryResultSnapshot::QueryResultSnapshot(uint64 rowCount, uint32 fieldCount, uint8 const* types) :
+    QueryResult(rowCount, fieldCount), m_pos(nullptr), m_end(nullptr)
+{
+    mCurrentRow = new Field[mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetType(Field::DataTypes(types[i]));
+}
+
+QueryResultSnapshot::~QueryResultSnapshot()
+{
+    delete[] mCurrentRow;
+}
+
+bool QueryResultSnapshot::NextRow()
+{
+    if (m_pos >= m_end)
+        return false;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        uint32 length;
+        memcpy(&length, m_pos, sizeof(length));
+        m_pos += sizeof(length);
+
+        if (length == NULL_FIELD)
+            mCurrentRow[i].SetValue(nullptr);
+        else
+        {
+            mCurrentRow[i].SetValue(m_pos);
+            m_pos += length + 1;
+        }
+    }
+
+    return true;
+}
+
+bool QueryResultSnapshot::Open(std::string const& fileName, uint64 key, QueryResult*& result)
+{
+    result = nullptr;
+
+    std::unique_ptr<MappedFile> file(new MappedFile);
+    if (!file->Open(fileName))
+        return false;
+
+    SnapshotHeader header;
+    if (file->GetSize() < sizeof(header))
+        return false;
+
+    memcpy(&header, file->GetData(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.key != key)
+        return false;
+
+    if (file->GetSize() != sizeof(header) + header.fieldCount + header.dataSize)
+        return false;
+
+    uint8 const* types = file->GetData() + sizeof(header);
+    char const* data = reinterpret_cast<char const*>(types + header.fieldCount);
+    if (DataChecksum(data, header.dataSize) != header.dataChecksum)
+    {
+        sLog.outError("Query snapshot %s is damaged, it will be recreated.", fileName.c_str());
+        return false;
+    }
+
+    if (!header.rowCount)
+        return true;
+
+    QueryResultSnapshot* snapshot = new QueryResultSnapshot(header.rowCount, header.fieldCount, types);
+    snapshot->m_pos = data;
+    snapshot->m_end = data + header.dataSize;
+    snapshot->m_file = std::move(file);                     // the fields point into the mapping
+
+    // same state as results returned by Database::Query
+    snapshot->NextRow();
+    result = snapshot;
+    return true;
+}
+
+QueryResult* QueryResultSnapshot::Create(std::string const& fileName, uint64 key, QueryResult* source)
+{
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.key = key;
+
+    std::vector<uint8> types;
+    QueryResultSnapshot* snapshot = nullptr;
+    if (source)
+    {
+        header.fieldCount = source->GetFieldCount();
+        header.rowCount = source->GetRowCount();
+
+        Field* fields = source->Fetch();
+        for (uint32 i = 0; i < header.fieldCount; ++i)
+            types.push_back(uint8(fields[i].GetType()));
+
+        snapshot = new QueryResultSnapshot(header.rowCount, header.fieldCount, types.data());
+
+        // source is positioned at its first row already
+        std::vector<char>& buffer = snapshot->m_buffer;
+        do
+        {
+            for (uint32 i = 0; i < header.fieldCount; ++i)
+            {
+                uint32 length = fields[i].IsNULL() ? NULL_FIELD : uint32(strlen(fields[i].GetString()));
+                char const* lengthBytes = reinterpret_cast<char const*>(&length);
+                buffer.insert(buffer.end(), lengthBytes, lengthBytes + sizeof(length));
+                if (length != NULL_FIELD)
+                    buffer.insert(buffer.end(), fields[i].GetString(), fields[i].GetString() + length + 1);
+            }
+        }
+        while (source->NextRow());
+
+        delete source;
+
+        header.dataSize = buffer.size();
+        header.dataChecksum = DataChecksum(buffer.data(), buffer.size());
+    }
+    else
+        header.dataChecksum = DataChecksum(nullptr, 0);
+
+    // write to a temporary file first, a server stopped while writing must not leave a valid looking snapshot
+    std::string tempName = fileName + ".tmp";
+    if (FILE* file = fopen(tempName.c_str(), "wb"))
+    {
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       (types.empty() || fwrite(types.data(), types.size(), 1, file) == 1) &&
+                       (!snapshot || snapshot->m_buffer.empty() || fwrite(snapshot->m_buffer.data(), snapshot->m_buffer.size(), 1, file) == 1);
+        fclose(file);
+
+        std::remove(fileName.c_str());
+        if (!written || std::rename(tempName.c_str(), fileName.c_str()) != 0)
+        {
+            sLog.outError("Can't write query snapshot %s.", fileName.c_str());
+            std::remove(tempName.c_str());
+        }
+    }
+    else
+        sLog.outError("Can't create query snapshot %s, check the snapshot directory.", fileName.c_str());
+
+    if (!snapshot)
+        return nullptr;
+
+    snapshot->m_pos = snapshot->m_buffer.data();
+    snapshot->m_end = snapshot->m_pos + snapshot->m_buffer.size();
+    snapshot->NextRow();
+    return snapshot;
+}
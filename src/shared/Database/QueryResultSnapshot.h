@@ -0,0 +1,57 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUERYRESULTSNAPSHOT_H
+#define QUERYRESULTSNAPSHOT_H
+
+#include "QueryResult.h"
+#include "MappedFile.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * Query result read from a snapshot file of an earlier identical query.
+ *
+ * The file holds a header with the key the snapshot was made for (query text, DB
+ * version and table checksums, see Database::QuerySnapshot) and a checksum of the
+ * row data. Rows are stored as length prefixed, zero terminated field strings, so
+ * the fields point directly into the mapped file.
+ */
+class QueryResultSnapshot : public QueryResult
+{
+    public:
+        ~QueryResultSnapshot();
+
+        bool NextRow() override;
+
+        // true if the file is a valid snapshot for the key, result is nullptr for an empty one
+        static bool Open(std::string const& fileName, uint64 key, QueryResult*& result);
+        // stores all rows of source (which is deleted) in the file, returns a result for the same rows
+        static QueryResult* Create(std::string const& fileName, uint64 key, QueryResult* source);
+
+    private:
+        QueryResultSnapshot(uint64 rowCount, uint32 fieldCount, uint8 const* types);
+
+        std::unique_ptr<MappedFile> m_file;
+        std::vector<char> m_buffer;                         // rows of a new snapshot when not mapped
+        char const* m_pos;
+        char const* m_end;
+};
+
+#endif
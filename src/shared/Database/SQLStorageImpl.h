@@ -235,7 +235,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         delete result;
     }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    result = WorldDatabase.QuerySnapshot(store.GetTableName(), store.GetTableName(), std::string("SELECT * FROM ") + store.GetTableName());
 
     if (!result)
     {
@@ -20,7 +20,13 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <chrono>
+
+// max amount of single statements committed in one transaction
+#define SQL_BATCH_SIZE 256
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool keyedWorker) :
+    m_dbEngine(db), m_dbConnection(conn), m_running(true), m_isKeyedWorker(keyedWorker), m_pending(0)
 {
 }
 
@@ -45,14 +51,28 @@ void SqlDelayThread::run()
     {
         // if the running state gets turned off while sleeping
         // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        if (m_isKeyedWorker)
+        {
+            // keyed executers are waited for by the dispatching thread, so start at once
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait_for(lock, std::chrono::milliseconds(loopSleepms), [this] { return !m_sqlQueue.empty() || !m_running; });
+        }
+        else
+            MaNGOS::Thread::Sleep(loopSleepms);
 
         ProcessRequests();
 
         if ((loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
-            m_dbEngine->Ping();
+            // the main thread pings all other connections
+            if (m_isKeyedWorker)
+            {
+                SqlConnection::Lock guard(m_dbConnection);
+                delete guard->Query("SELECT 1");
+            }
+            else
+                m_dbEngine->Ping();
         }
     }
 
@@ -63,7 +83,9 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
+    std::lock_guard<std::mutex> guard(m_queueMutex);
     m_running = false;
+    m_queueCondition.notify_one();
 }
 
 void SqlDelayThread::ProcessRequests()
@@ -79,8 +101,84 @@ void SqlDelayThread::ProcessRequests()
 
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        std::unique_ptr<SqlOperation> s = std::move(sqlQueue.front());
         sqlQueue.pop();
-        s->Execute(m_dbConnection);
+
+        // keyed transactions run in parallel, ordered only with the same key
+        if (uint32 key = s->GetSerialKey())
+        {
+            if (!m_keyedWorkers.empty())
+            {
+                m_keyedWorkers[key % m_keyedWorkers.size()]->Delay(s.release());
+                --m_pending;
+                continue;
+            }
+        }
+
+        // everything else keeps its order to all requests queued before and after it
+        WaitKeyedWorkers();
+
+        ExecuteRequest(std::move(s), sqlQueue);
+    }
+}
+
+void SqlDelayThread::ExecuteRequest(std::unique_ptr<SqlOperation> sql, std::queue<std::unique_ptr<SqlOperation>>& sqlQueue)
+{
+    if (!sql->IsBatchable() || sqlQueue.empty() || !sqlQueue.front()->IsBatchable())
+    {
+        sql->Execute(m_dbConnection);
+        sql.reset();
+    }
+    else
+    {
+        // commit consecutive single statements together instead of one by one
+        std::vector<std::unique_ptr<SqlOperation>> batch;
+        batch.push_back(std::move(sql));
+        while (batch.size() < SQL_BATCH_SIZE && !sqlQueue.empty() && sqlQueue.front()->IsBatchable())
+        {
+            batch.push_back(std::move(sqlQueue.front()));
+            sqlQueue.pop();
+        }
+
+        SqlConnection::Lock guard(m_dbConnection);
+
+        bool success = guard->BeginTransaction();
+        for (size_t i = 0; success && i < batch.size(); ++i)
+            success = batch[i]->Execute(m_dbConnection);
+
+        if (success)
+            success = guard->CommitTransaction();
+
+        // a deadlock or timeout may have rolled back the whole batch, run the statements
+        // one by one as they were queued so a failing one does not affect the others
+        if (!success)
+        {
+            guard->RollbackTransaction();
+            sLog.outError("SqlDelayThread: batch of %u statements failed, executing them one by one", uint32(batch.size()));
+
+            for (auto& statement : batch)
+                statement->Execute(m_dbConnection);
+        }
+
+        m_pending -= batch.size() - 1;
+    }
+
+    // last one wakes up WaitIdle()
+    if (--m_pending == 0 && m_isKeyedWorker)
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_idleCondition.notify_all();
     }
 }
+
+void SqlDelayThread::WaitKeyedWorkers()
+{
+    for (auto worker : m_keyedWorkers)
+        worker->WaitIdle();
+}
+
+void SqlDelayThread::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_idleCondition.wait(lock, [this] { return m_pending == 0; });
+}
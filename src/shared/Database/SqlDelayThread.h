@@ -23,8 +23,11 @@
 #include "SqlOperations.h"
 
 #include <mutex>
+#include <condition_variable>
 #include <queue>
+#include <vector>
 #include <memory>
+#include <atomic>
 
 class Database;
 class SqlOperation;
@@ -39,21 +42,39 @@ class SqlDelayThread : public MaNGOS::Runnable
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
         volatile bool m_running;
 
+        // keyed transaction executers this thread dispatches to, see Database::BeginTransaction
+        std::vector<SqlDelayThread*> m_keyedWorkers;
+        // set for the keyed executers themselves
+        bool m_isKeyedWorker;
+        std::atomic<uint32> m_pending;                          ///< Requests queued or in execution
+        std::condition_variable m_queueCondition;
+        std::condition_variable m_idleCondition;
+
         // process all enqueued requests
         void ProcessRequests();
+        // execute one request, or a run of single statements starting with it in one transaction
+        void ExecuteRequest(std::unique_ptr<SqlOperation> sql, std::queue<std::unique_ptr<SqlOperation>>& sqlQueue);
+        // wait until all requests handed to keyed executers are done
+        void WaitKeyedWorkers();
+        void WaitIdle();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool keyedWorker = false);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
             std::lock_guard<std::mutex> guard(m_queueMutex);
+            ++m_pending;
             m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            if (m_isKeyedWorker)
+                m_queueCondition.notify_one();
             return true;
         }
 
+        void AddKeyedWorker(SqlDelayThread* worker) { m_keyedWorkers.push_back(worker); }
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
@@ -96,6 +96,23 @@ bool SqlQuery::Execute(SqlConnection* conn)
     return true;
 }
 
+bool SqlDirectQuery::Execute(SqlConnection* conn)
+{
+    if (!m_handler)
+        return false;
+
+    QueryResult* result;
+    {
+        LOCK_DB_CONN(conn);
+        result = conn->Query(&m_sql[0]);
+    }
+
+    /// the handler takes the result and runs without the connection lock
+    m_handler(result);
+
+    return true;
+}
+
 void SqlResultQueue::Update()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
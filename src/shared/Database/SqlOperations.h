@@ -26,6 +26,7 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <functional>
 
 /// ---- BASE ---
 
@@ -39,6 +40,10 @@ class SqlOperation
     public:
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection* conn) = 0;
+        // single statement without result, may be committed together with its neighbours
+        virtual bool IsBatchable() const { return false; }
+        // non zero for requests only ordered with others of the same key
+        virtual uint32 GetSerialKey() const { return 0; }
         virtual ~SqlOperation() {}
 };
 
@@ -52,18 +57,21 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 };
 
 class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        uint32 m_serialKey;
 
     public:
-        SqlTransaction() {}
+        explicit SqlTransaction(uint32 serialKey = 0) : m_serialKey(serialKey) {}
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        uint32 GetSerialKey() const override { return m_serialKey; }
 
         bool Execute(SqlConnection* conn) override;
 };
@@ -75,6 +83,7 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 
     private:
         const int m_nIndex;
@@ -116,6 +125,23 @@ class SqlQuery : public SqlOperation
         bool Execute(SqlConnection* conn) override;
 };
 
+// async query handing its result to a function on the delay thread, for callers without result queue polling
+class SqlDirectQuery : public SqlOperation
+{
+    private:
+        std::vector<char> m_sql;
+        std::function<void(QueryResult*)> m_handler;
+
+    public:
+        SqlDirectQuery(const char* sql, std::function<void(QueryResult*)> handler)
+            : m_sql(strlen(sql) + 1), m_handler(std::move(handler))
+        {
+            memcpy(&m_sql[0], sql, m_sql.size());
+        }
+
+        bool Execute(SqlConnection* conn) override;
+};
+
 class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
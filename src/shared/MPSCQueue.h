@@ -0,0 +1,129 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MPSC_QUEUE_H
+#define _MPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+
+// Intrusive link of MPSCQueue elements, not copied together with its owner
+template <typename T>
+struct MPSCQueueLink
+{
+    MPSCQueueLink() : next(nullptr) {}
+    MPSCQueueLink(const MPSCQueueLink&) : next(nullptr) {}
+    MPSCQueueLink& operator=(const MPSCQueueLink&) { return *this; }
+
+    std::atomic<T*> next;
+};
+
+// Lock-free intrusive multi-producer/single-consumer queue (D. Vyukov)
+// Push() may be called from any thread, Peek()/Pop() only by one consumer at a time.
+// The queue owns its elements, they are handed over and returned as std::unique_ptr.
+// T must be default constructible and have a public MPSCQueueLink<T> m_queueLink member,
+// it only has to be complete where the queue is constructed and used.
+template <typename T>
+class MPSCQueue
+{
+    public:
+        MPSCQueue() : m_stub(new T), m_head(m_stub), m_tail(m_stub), m_peeked(nullptr) {}
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+        ~MPSCQueue()
+        {
+            while (Pop());
+            delete m_stub;
+        }
+
+        void Push(std::unique_ptr<T> value)
+        {
+            PushNode(value.release());
+        }
+
+        // oldest element or nullptr, it stays in the queue
+        T* Peek()
+        {
+            if (!m_peeked)
+                m_peeked = PopNode();
+
+            return m_peeked;
+        }
+
+        std::unique_ptr<T> Pop()
+        {
+            T* node = Peek();
+            m_peeked = nullptr;
+            return std::unique_ptr<T>(node);
+        }
+
+        bool Empty() { return Peek() == nullptr; }
+
+    private:
+        void PushNode(T* node)
+        {
+            node->m_queueLink.next.store(nullptr, std::memory_order_relaxed);
+            T* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->m_queueLink.next.store(node, std::memory_order_release);
+        }
+
+        T* PopNode()
+        {
+            T* tail = m_tail;
+            T* next = tail->m_queueLink.next.load(std::memory_order_acquire);
+
+            if (tail == m_stub)
+            {
+                if (!next)
+                    return nullptr;
+
+                m_tail = next;
+                tail = next;
+                next = next->m_queueLink.next.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            // a producer is between exchange and link, the element is not visible yet
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            PushNode(m_stub);
+
+            next = tail->m_queueLink.next.load(std::memory_order_acquire);
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            return nullptr;
+        }
+
+        T* const m_stub;
+        std::atomic<T*> m_head;                             // producer end
+        T* m_tail;                                          // consumer end
+        T* m_peeked;
+};
+
+#endif
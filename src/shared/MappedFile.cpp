@@ -0,0 +1,51 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MappedFile.h"
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+
+bool MappedFile::Open(std::string const& fileName, bool copyOnWrite)
+{
+    Close();
+
+    try
+    {
+        // the region stays valid after the file mapping is destroyed, which closes the file descriptor
+        // so many mapped grids and tiles don't use up the descriptors needed by sockets
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, copyOnWrite ? boost::interprocess::copy_on_write : boost::interprocess::read_only);
+
+        m_region.swap(region);
+        m_copyOnWrite = copyOnWrite;
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        // missing, empty or not mappable file, callers fall back to reading it
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    boost::interprocess::mapped_region region;
+    m_region.swap(region);
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPPEDFILE_H
+#define MANGOS_MAPPEDFILE_H
+
+#include "Platform/Define.h"
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <string>
+
+// Memory mapping of a whole file, pages are loaded by the OS on first access
+// the file itself is not kept open
+class MappedFile
+{
+    public:
+        MappedFile() : m_copyOnWrite(false) {}
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        // false if the file does not exist, is empty or can't be mapped
+        // with copyOnWrite the data may be written, written pages become private copies and the file stays unchanged
+        bool Open(std::string const& fileName, bool copyOnWrite = false);
+        void Close();
+
+        bool IsOpen() const { return m_region.get_address() != nullptr; }
+        uint8 const* GetData() const { return static_cast<uint8 const*>(m_region.get_address()); }
+        uint8* GetWritableData() { return m_copyOnWrite ? static_cast<uint8*>(m_region.get_address()) : nullptr; }
+        size_t GetSize() const { return m_region.get_size(); }
+
+    private:
+        boost::interprocess::mapped_region m_region;
+        bool m_copyOnWrite;
+};
+
+#endif
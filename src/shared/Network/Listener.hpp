@@ -20,9 +20,11 @@
 #define __LISTENER_HPP_
 
 #include "NetworkThread.hpp"
+#include "Log.h"
 
 #include <boost/asio.hpp>
 
+#include <future>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -39,9 +41,17 @@ namespace MaNGOS
             std::thread m_acceptorThread;
             std::vector<std::unique_ptr<NetworkThread<SocketType>>> m_workerThreads;
 
+            // one acceptor per worker on the same port, the kernel spreads new connections between them
+            std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> m_workerAcceptors;
+
             // the time in milliseconds to sleep a worker thread at the end of each tick
             const int SleepInterval = 100;
 
+            // the time in milliseconds to wait before accepting again after a failed accept, e.g. out of file descriptors
+            static const int AcceptRetryDelay = 500;
+
+            std::unique_ptr<boost::asio::deadline_timer> m_acceptRetryTimer;
+
             NetworkThread<SocketType> *SelectWorker() const
             {
                 int minIndex = 0;
@@ -64,19 +74,41 @@ namespace MaNGOS
             void BeginAccept();
             void OnAccept(NetworkThread<SocketType> *worker, std::shared_ptr<SocketType> const& socket, const boost::system::error_code &ec);
 
+            bool OpenWorkerAcceptors(boost::asio::ip::tcp::endpoint const& endpoint);
+            static bool IsPortInUse(boost::asio::ip::tcp::endpoint const& endpoint);
+            static void BeginWorkerAccept(NetworkThread<SocketType> *worker, std::shared_ptr<boost::asio::ip::tcp::acceptor> const& acceptor);
+
         public:
-            Listener(std::string const& address, int port, int workerThreads);
+            // reusePort: accept on every worker thread with SO_REUSEPORT instead of a single acceptor thread
+            // falls back to the single acceptor where the option is not available
+            Listener(std::string const& address, int port, int workerThreads, bool reusePort = false);
             ~Listener();
     };
 
     template <typename SocketType>
-    Listener<SocketType>::Listener(std::string const& address, int port, int workerThreads)
-        : m_service(new boost::asio::io_service()), m_acceptor(new boost::asio::ip::tcp::acceptor(*m_service, boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(address), port)))
+    const int Listener<SocketType>::AcceptRetryDelay;
+
+    template <typename SocketType>
+    Listener<SocketType>::Listener(std::string const& address, int port, int workerThreads, bool reusePort)
     {
         m_workerThreads.reserve(workerThreads);
         for (auto i = 0; i < workerThreads; ++i)
             m_workerThreads.push_back(std::unique_ptr<NetworkThread<SocketType>>(new NetworkThread<SocketType>));
 
+        boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(address), port);
+
+        if (reusePort && OpenWorkerAcceptors(endpoint))
+        {
+            for (size_t i = 0; i < m_workerAcceptors.size(); ++i)
+                BeginWorkerAccept(m_workerThreads[i].get(), m_workerAcceptors[i]);
+
+            return;
+        }
+
+        m_service.reset(new boost::asio::io_service());
+        m_acceptor.reset(new boost::asio::ip::tcp::acceptor(*m_service, endpoint));
+        m_acceptRetryTimer.reset(new boost::asio::deadline_timer(*m_service));
+
         BeginAccept();
 
         m_acceptorThread = std::thread([this]() { this->m_service->run(); });
@@ -86,13 +118,135 @@ namespace MaNGOS
     template <typename SocketType>
     Listener<SocketType>::~Listener()
     {
+        // worker acceptors belong to running worker services, close them there
+        for (size_t i = 0; i < m_workerAcceptors.size(); ++i)
+        {
+            std::promise<void> closed;
+            std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor = m_workerAcceptors[i];
+            m_workerThreads[i]->GetService().post([acceptor, &closed]()
+            {
+                boost::system::error_code ec;
+                acceptor->close(ec);
+                closed.set_value();
+            });
+            closed.get_future().wait();
+        }
+
+        if (!m_acceptor)
+            return;
+
         m_acceptor->close();
         m_service->stop();
         m_acceptorThread.join();
+        m_acceptRetryTimer.reset();
         m_acceptor.reset();
         m_service.reset();
     }
 
+    template <typename SocketType>
+    bool Listener<SocketType>::OpenWorkerAcceptors(boost::asio::ip::tcp::endpoint const& endpoint)
+    {
+#ifdef SO_REUSEPORT
+        typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+
+        // every acceptor with SO_REUSEPORT of the same user could bind the port, another server instance included
+        if (IsPortInUse(endpoint))
+        {
+            sLog.outError("Listener: port %u is already in use, not sharing it with SO_REUSEPORT", uint32(endpoint.port()));
+            return false;
+        }
+
+        boost::system::error_code ec;
+        for (auto& worker : m_workerThreads)
+        {
+            std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor(new boost::asio::ip::tcp::acceptor(worker->GetService()));
+
+            acceptor->open(endpoint.protocol(), ec);
+            if (!ec)
+                acceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), ec);
+            if (!ec)
+                acceptor->set_option(reuse_port(true), ec);
+            if (!ec)
+                acceptor->bind(endpoint, ec);
+            if (!ec)
+                acceptor->listen(boost::asio::socket_base::max_connections, ec);
+
+            if (ec)
+            {
+                sLog.outError("Listener: SO_REUSEPORT acceptor on port %u failed (%s), using a single acceptor thread", uint32(endpoint.port()), ec.message().c_str());
+                // nothing was started yet, so they can be closed from here
+                for (auto& opened : m_workerAcceptors)
+                    opened->close(ec);
+                m_workerAcceptors.clear();
+                return false;
+            }
+
+            m_workerAcceptors.push_back(std::move(acceptor));
+        }
+
+        return true;
+#else
+        sLog.outError("Listener: SO_REUSEPORT is not supported on this platform, using a single acceptor thread");
+        return false;
+#endif
+    }
+
+    template <typename SocketType>
+    bool Listener<SocketType>::IsPortInUse(boost::asio::ip::tcp::endpoint const& endpoint)
+    {
+        // a socket without SO_REUSEPORT can not bind while any other socket listens on the port
+        boost::asio::io_service service;
+        boost::asio::ip::tcp::acceptor probe(service);
+        boost::system::error_code ec;
+
+        probe.open(endpoint.protocol(), ec);
+        if (!ec)
+            probe.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), ec);
+        if (!ec)
+            probe.bind(endpoint, ec);
+
+        bool inUse = ec == boost::asio::error::address_in_use;
+        probe.close(ec);
+        return inUse;
+    }
+
+    template <typename SocketType>
+    void Listener<SocketType>::BeginWorkerAccept(NetworkThread<SocketType> *worker, std::shared_ptr<boost::asio::ip::tcp::acceptor> const& acceptor)
+    {
+        auto socket = worker->CreateSocket();
+
+        // accept completes on the worker thread owning the socket, no hand over needed
+        // the handler does not touch the listener, it may be gone once the acceptor is closed
+        acceptor->async_accept(socket->GetAsioSocket(),
+            [worker, acceptor, socket] (const boost::system::error_code &ec)
+        {
+            if (ec)
+                worker->RemoveSocket(socket.get());
+            else
+                socket->Open();
+
+            // closed by the listener destructor on this same thread
+            if (!acceptor->is_open())
+                return;
+
+            if (!ec)
+            {
+                BeginWorkerAccept(worker, acceptor);
+                return;
+            }
+
+            // accept keeps failing while e.g. the file descriptors are exhausted, do not retry in a tight loop
+            sLog.outError("Listener: accept failed (%s), retrying in %d ms", ec.message().c_str(), AcceptRetryDelay);
+            std::shared_ptr<boost::asio::deadline_timer> timer(new boost::asio::deadline_timer(worker->GetService()));
+            timer->expires_from_now(boost::posix_time::milliseconds(AcceptRetryDelay));
+            timer->async_wait([worker, acceptor, timer] (const boost::system::error_code&)
+            {
+                if (acceptor->is_open())
+                    BeginWorkerAccept(worker, acceptor);
+            });
+        });
+    }
+
     template <typename SocketType>
     void Listener<SocketType>::BeginAccept()
     {
@@ -115,7 +269,24 @@ namespace MaNGOS
         else
             socket->Open();
 
-        BeginAccept();
+        if (!ec)
+        {
+            BeginAccept();
+            return;
+        }
+
+        // the acceptor was closed by the destructor
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        // accept keeps failing while e.g. the file descriptors are exhausted, do not retry in a tight loop
+        sLog.outError("Listener: accept failed (%s), retrying in %d ms", ec.message().c_str(), AcceptRetryDelay);
+        m_acceptRetryTimer->expires_from_now(boost::posix_time::milliseconds(AcceptRetryDelay));
+        m_acceptRetryTimer->async_wait([this] (const boost::system::error_code &error)
+        {
+            if (!error)
+                this->BeginAccept();
+        });
     }
 }
 
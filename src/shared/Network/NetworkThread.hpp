@@ -67,6 +67,8 @@ namespace MaNGOS
 
             size_t Size() const { return m_sockets.size(); }
 
+            boost::asio::io_service& GetService() { return m_service; }
+
             std::shared_ptr<SocketType> CreateSocket();
 
             void RemoveSocket(Socket *socket)
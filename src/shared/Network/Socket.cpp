@@ -26,6 +26,8 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <algorithm>
+#include <cassert>
 #include <vector>
 #include <functional>
 #include <cstring>
@@ -33,8 +35,9 @@
 namespace MaNGOS
 {
     Socket::Socket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-        : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_socket(service),
-          m_closeHandler(std::move(closeHandler)), m_outBufferFlushTimer(service), m_address("0.0.0.0") {}
+        : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_readSuspended(false), m_service(service), m_socket(service),
+          m_closeHandler(std::move(closeHandler)), m_outQueueSending(0), m_outQueueBytes(0), m_bufferTimeout(MaxBufferTimeout),
+          m_outBufferFlushTimer(service), m_address("0.0.0.0") {}
 
     bool Socket::Open()
     {
@@ -49,8 +52,6 @@ namespace MaNGOS
             return false;
         }
 
-        m_outBuffer.reset(new PacketBuffer);
-        m_secondaryOutBuffer.reset(new PacketBuffer);
         m_inBuffer.reset(new PacketBuffer);
 
         StartAsyncRead();
@@ -114,6 +115,11 @@ namespace MaNGOS
             return;
         }
 
+        ProcessInBuffer();
+    }
+
+    void Socket::ProcessInBuffer()
+    {
         // we must repeat this in case we have read in multiple messages from the client
         while (m_inBuffer->m_readPosition < m_inBuffer->m_writePosition)
         {
@@ -137,6 +143,13 @@ namespace MaNGOS
 
                 return;
             }
+
+            // the rest of the buffer waits for ResumeRead(), no read is started meanwhile
+            if (m_readSuspended)
+            {
+                m_readState = ReadState::Idle;
+                return;
+            }
         }
 
         // at this point, the packet has been read and successfully processed.  reset the buffer.
@@ -145,6 +158,28 @@ namespace MaNGOS
         StartAsyncRead();
     }
 
+    void Socket::ResumeRead(std::function<bool()> continuation)
+    {
+        std::shared_ptr<Socket> ptr = shared<Socket>();
+        m_service.post([ptr, continuation]()
+        {
+            if (ptr->IsClosed())
+                return;
+
+            ptr->m_readSuspended = false;
+
+            if (!continuation())
+            {
+                ptr->Close();
+                return;
+            }
+
+            // the continuation may wait for something else again
+            if (!ptr->m_readSuspended)
+                ptr->ProcessInBuffer();
+        });
+    }
+
     void Socket::OnError(const boost::system::error_code& error)
     {
         // skip logging this code because it happens whenever anyone disconnects.  reduces spam.
@@ -169,33 +204,104 @@ namespace MaNGOS
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
+        AppendOut(header, headerSize);
+        AppendOut(content, contentSize);
 
-        // write the header
-        outBuffer->Write(header, headerSize);
+        OnOutAppended();
+    }
 
-        // write the content
-        outBuffer->Write(content, contentSize);
+    void Socket::Write(const char* header, int headerSize, std::shared_ptr<const uint8> content, int contentSize)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
 
-        // flush data if need
-        if (m_writeState == WriteState::Idle)
-            StartWriteFlushTimer();
+        AppendOut(header, headerSize);
+        AppendOut(std::move(content), contentSize);
+
+        OnOutAppended();
     }
 
     void Socket::Write(const char* buffer, int length)
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
+        AppendOut(buffer, length);
+
+        OnOutAppended();
+    }
 
-        // write the header
-        outBuffer->Write(buffer, length);
+// note that this function assumes that the socket mutex is locked
+    void Socket::AppendOut(const char* buffer, int length)
+    {
+        assert(buffer != nullptr && length != 0);
+
+        OutSegment* last = m_outQueue.size() > m_outQueueSending ? &m_outQueue.back() : nullptr;
+
+        // copy into the last segment if it is not being sent and has room for the data without reallocation
+        if (last && !last->shared && !last->inSlab && last->owned.capacity() - last->owned.size() >= size_t(length))
+        {
+            last->owned.insert(last->owned.end(), buffer, buffer + length);
+            m_outQueueBytes += length;
+            return;
+        }
+
+        // small writes, e.g. the header following a shared payload, go to the slab rather than a new buffer
+        if (size_t(length) <= SlabWriteSize)
+        {
+            if (!last || !last->inSlab || last->slabOffset + last->slabSize != m_outSlab.size())
+            {
+                m_outQueue.emplace_back();
+                last = &m_outQueue.back();
+                last->inSlab = true;
+                last->slabOffset = m_outSlab.size();
+            }
 
+            m_outSlab.insert(m_outSlab.end(), buffer, buffer + length);
+            last->slabSize += length;
+            m_outQueueBytes += length;
+            return;
+        }
+
+        m_outQueue.emplace_back();
+        std::vector<uint8>& owned = m_outQueue.back().owned;
+        if (!m_freeOutBuffers.empty())
+        {
+            owned.swap(m_freeOutBuffers.back());
+            m_freeOutBuffers.pop_back();
+        }
+        owned.reserve(std::max<size_t>(DEFAULT_BUFFER_SIZE, length));
+
+        owned.insert(owned.end(), buffer, buffer + length);
+        m_outQueueBytes += length;
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::AppendOut(std::shared_ptr<const uint8> buffer, int length)
+    {
+        assert(buffer && length != 0);
+
+        // referencing a small payload costs more than copying it next to its header
+        if (size_t(length) <= SlabWriteSize)
+        {
+            AppendOut(reinterpret_cast<const char*>(buffer.get()), length);
+            return;
+        }
+
+        m_outQueue.emplace_back();
+        m_outQueue.back().shared = std::move(buffer);
+        m_outQueue.back().sharedSize = length;
+        m_outQueueBytes += length;
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::OnOutAppended()
+    {
         // flush data if need
         if (m_writeState == WriteState::Idle)
             StartWriteFlushTimer();
+
+        // enough data to fill several tcp segments, do not wait any longer
+        if (m_writeState == WriteState::Buffering && m_outQueueBytes >= FlushThreshold)
+            m_outBufferFlushTimer.cancel();
     }
 
 // note that this function assumes that the socket mutex is locked
@@ -214,7 +320,7 @@ namespace MaNGOS
         m_writeState = WriteState::Buffering;
 
         std::shared_ptr<Socket> ptr = shared<Socket>();
-        m_outBufferFlushTimer.expires_from_now(boost::posix_time::milliseconds(int(BufferTimeout)));
+        m_outBufferFlushTimer.expires_from_now(boost::posix_time::milliseconds(m_bufferTimeout));
         m_outBufferFlushTimer.async_wait([ptr](const boost::system::error_code&) { ptr->FlushOut(); });
     }
 
@@ -231,12 +337,36 @@ namespace MaNGOS
 
         assert(m_writeState == WriteState::Buffering);
 
-        // at this point we are guarunteed that there is data to send in the primary buffer.  send it.
+        // adapt the buffering delay to the amount of data it collected
+        if (m_outQueueBytes < SmallFlushSize)
+            m_bufferTimeout = std::max(int(MinBufferTimeout), m_bufferTimeout / 2);
+        else
+            m_bufferTimeout = std::min(int(MaxBufferTimeout), m_bufferTimeout * 2);
+
+        // at this point we are guarunteed that there is data to send in the queue.  send it.
         m_writeState = WriteState::Sending;
 
+        StartSend();
+    }
+
+// note that this function assumes that the socket mutex is locked
+// all queued segments are sent with a single gathering write
+    void Socket::StartSend()
+    {
+        // the slab of the previous write is done, the queued segments keep pointing into theirs until sent
+        m_sendingSlab.swap(m_outSlab);
+        m_outSlab.clear();
+
+        m_sendBuffers.clear();
+        for (OutSegment const& segment : m_outQueue)
+            m_sendBuffers.push_back(boost::asio::buffer(segment.data(m_sendingSlab), segment.size()));
+
+        m_outQueueSending = m_outQueue.size();
+        m_outQueueBytes = 0;
+
         std::shared_ptr<Socket> ptr = shared<Socket>();
-        m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                  make_custom_alloc_handler(m_allocator,
+        boost::asio::async_write(m_socket, m_sendBuffers,
+                                 make_custom_alloc_handler(m_allocator,
         [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length); }));
     }
 
@@ -248,7 +378,7 @@ namespace MaNGOS
         m_outBufferFlushTimer.cancel();
     }
 
-    void Socket::OnWriteComplete(const boost::system::error_code& error, size_t length)
+    void Socket::OnWriteComplete(const boost::system::error_code& error, size_t /*length*/)
     {
         // we must check this before locking the mutex because the connection will be closed,
         // which leads to a locked mutex being destroyed.  not good!
@@ -267,37 +397,26 @@ namespace MaNGOS
         std::lock_guard<std::mutex> guard(m_mutex);
 
         assert(m_writeState == WriteState::Sending);
-        assert(length <= m_outBuffer->m_writePosition);
 
-        // if there is data left to write, move it to the start of the buffer
-        if (length < m_outBuffer->m_writePosition)
+        // async_write completes only once everything handed to it is sent
+        for (; m_outQueueSending > 0; --m_outQueueSending)
         {
-            memcpy(&(m_outBuffer->m_buffer[0]), &(m_outBuffer->m_buffer[length]), (m_outBuffer->m_writePosition - length) * sizeof(m_outBuffer->m_buffer[0]));
-            m_outBuffer->m_writePosition -= length;
+            OutSegment& segment = m_outQueue.front();
+            if (!segment.shared && !segment.inSlab && m_freeOutBuffers.size() < 4 && segment.owned.capacity() <= 4 * DEFAULT_BUFFER_SIZE)
+            {
+                segment.owned.clear();
+                m_freeOutBuffers.push_back(std::move(segment.owned));
+            }
+            m_outQueue.pop_front();
         }
-        // if not, reset the write pointer
-        else
-            m_outBuffer->m_writePosition = 0;
 
-        // if there is data in the secondary buffer, append it to the primary buffer
-        if (m_secondaryOutBuffer->m_writePosition > 0)
-        {
-            // do we have enough space? if not, resize
-            if (m_outBuffer->m_buffer.size() < (m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition))
-                m_outBuffer->m_buffer.resize(m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition);
+        // do not keep the memory of a burst of small writes around
+        if (m_sendingSlab.capacity() > 4 * DEFAULT_BUFFER_SIZE)
+            std::vector<uint8>().swap(m_sendingSlab);
 
-            memcpy(&(m_outBuffer->m_buffer[m_outBuffer->m_writePosition]), &(m_secondaryOutBuffer->m_buffer[0]), (m_secondaryOutBuffer->m_writePosition) * sizeof(m_secondaryOutBuffer->m_buffer[0]));
-
-            m_outBuffer->m_writePosition += m_secondaryOutBuffer->m_writePosition;
-            m_secondaryOutBuffer->m_writePosition = 0;
-        }
-
-        std::shared_ptr<Socket> ptr = shared<Socket>();
         // if there is any data to write, do so immediately
-        if (m_outBuffer->m_writePosition > 0)
-            m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                      make_custom_alloc_handler(m_allocator,
-            [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length);}));
+        if (!m_outQueue.empty())
+            StartSend();
         else
             m_writeState = WriteState::Idle;
     }
@@ -25,8 +25,10 @@
 
 #include <boost/asio.hpp>
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 #include <mutex>
 #include <functional>
 
@@ -35,9 +37,18 @@ namespace MaNGOS
     class Socket : public std::enable_shared_from_this<Socket>
     {
         private:
-            // buffer timeout period, in milliseconds.  higher values decrease responsiveness
-            // ingame but increase bandwidth efficiency by reducing tcp overhead.
-            static const int BufferTimeout = 50;
+            // buffering delay bounds, in milliseconds.  the delay shrinks while flushes stay small
+            // (sparse traffic gains nothing from waiting) and grows while they are large, to save tcp overhead.
+            static const int MinBufferTimeout = 5;
+            static const int MaxBufferTimeout = 50;
+
+            // buffered data above this size is sent without waiting for the timer
+            static const size_t FlushThreshold = 8192;
+            // flushes below this size count as sparse traffic
+            static const size_t SmallFlushSize = 512;
+            // writes up to this size that need a new segment go to the slab instead of a buffer of their own,
+            // shared payloads up to this size are copied rather than referenced
+            static const size_t SlabWriteSize = 256;
 
             enum class WriteState
             {
@@ -52,16 +63,41 @@ namespace MaNGOS
                 Reading
             };
 
+            // part of the outgoing stream, either copied data, a range of the slab or a reference to shared immutable data
+            struct OutSegment
+            {
+                OutSegment() : sharedSize(0), inSlab(false), slabOffset(0), slabSize(0) {}
+
+                std::vector<uint8> owned;
+                std::shared_ptr<const uint8> shared;
+                size_t sharedSize;
+                bool inSlab;
+                size_t slabOffset;
+                size_t slabSize;
+
+                const uint8* data(std::vector<uint8> const& slab) const { return shared ? shared.get() : inSlab ? &slab[slabOffset] : owned.data(); }
+                size_t size() const { return shared ? sharedSize : inSlab ? slabSize : owned.size(); }
+            };
+
             WriteState m_writeState;
             ReadState m_readState;
+            bool m_readSuspended;                           // received data is left unprocessed until ResumeRead()
 
+            boost::asio::io_service& m_service;
             boost::asio::ip::tcp::socket m_socket;
 
             std::function<void(Socket *)> m_closeHandler;
 
             std::unique_ptr<PacketBuffer> m_inBuffer;
-            std::unique_ptr<PacketBuffer> m_outBuffer;
-            std::unique_ptr<PacketBuffer> m_secondaryOutBuffer;
+
+            std::deque<OutSegment> m_outQueue;
+            size_t m_outQueueSending;                       // segments at the front owned by the running write
+            size_t m_outQueueBytes;                         // queued bytes not yet handed to a write
+            std::vector<std::vector<uint8>> m_freeOutBuffers;
+            std::vector<uint8> m_outSlab;                   // small writes of the queued segments, mostly packet headers
+            std::vector<uint8> m_sendingSlab;               // slab of the running write, swapped with m_outSlab on send
+            std::vector<boost::asio::const_buffer> m_sendBuffers;
+            int m_bufferTimeout;
 
             std::mutex m_mutex;
             std::mutex m_closeMutex;
@@ -69,8 +105,14 @@ namespace MaNGOS
 
             void StartAsyncRead();
             void OnRead(const boost::system::error_code &error, size_t length);
+            void ProcessInBuffer();
+
+            void AppendOut(const char *buffer, int length);
+            void AppendOut(std::shared_ptr<const uint8> buffer, int length);
+            void OnOutAppended();
 
             void StartWriteFlushTimer();
+            void StartSend();
             void OnWriteComplete(const boost::system::error_code &error, size_t length);
             void FlushOut();
 
@@ -88,6 +130,13 @@ namespace MaNGOS
 
             void ForceFlushOut();
 
+            // stop handling received data after the current packet, e.g. while waiting for a database result
+            void SuspendRead() { m_readSuspended = true; }
+            bool IsReadSuspended() const { return m_readSuspended; }
+            // run continuation on the network thread and handle the data received meanwhile, may be called
+            // from any thread. the socket is closed if continuation returns false
+            void ResumeRead(std::function<bool()> continuation);
+
         public:
             Socket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler);
             virtual ~Socket() = default;
@@ -103,6 +152,8 @@ namespace MaNGOS
 
             void Write(const char *buffer, int length);
             void Write(const char *header, int headerSize, const char* content, int contentSize);
+            // content is referenced until sent, not copied, so it can be shared by many sockets
+            void Write(const char *header, int headerSize, std::shared_ptr<const uint8> content, int contentSize);
 
             boost::asio::ip::tcp::socket &GetAsioSocket() { return m_socket; }
 
@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "ByteBuffer.h"
+#include "MPSCQueue.h"
 #include "Server/Opcodes.h"
 
 // Note: m_opcode and size stored in platfom dependent format
@@ -49,6 +50,9 @@ class WorldPacket : public ByteBuffer
         void SetOpcode(Opcodes opcode) { m_opcode = opcode; }
         inline const char* GetOpcodeName() const { return LookupOpcodeName(m_opcode); }
 
+        // link in WorldSession receive queue
+        MPSCQueueLink<WorldPacket> m_queueLink;
+
     protected:
         Opcodes m_opcode;
 };